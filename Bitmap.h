@@ -0,0 +1,131 @@
+// Bitmap.h
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// The `Bitmap` class is a growable vector of bits packed into 64-bit words. Besides plain bit
+// access it can count the set bits with popcount and visit them in ascending order while skipping
+// whole zero words, which makes "which positions are set" queries proportional to the number of
+// words plus the number of hits rather than to the number of positions.
+class Bitmap {
+public:
+    /**
+     * @brief Append a bit
+     *
+     * @param value The value of the new bit
+     */
+    void push_back(bool value) {
+        if (bitCount % WORD_BITS == 0) {
+            words.push_back(0);
+        }
+        ++bitCount;
+        set(bitCount - 1, value);
+    }
+
+    /**
+     * @brief Set the bit at `position`
+     *
+     * @param position The bit position
+     * @param value The new value
+     */
+    void set(std::size_t position, bool value) {
+        const std::uint64_t mask = std::uint64_t{ 1 } << (position % WORD_BITS);
+        if (value) {
+            words[position / WORD_BITS] |= mask;
+        } else {
+            words[position / WORD_BITS] &= ~mask;
+        }
+    }
+
+    /**
+     * @brief Get the bit at `position`
+     *
+     * @param position The bit position
+     * @return bool The bit's value
+     */
+    bool test(std::size_t position) const {
+        return (words[position / WORD_BITS] >> (position % WORD_BITS)) & 1u;
+    }
+
+    bool operator[](std::size_t position) const { return test(position); }
+
+    /**
+     * @brief Get the number of bits
+     *
+     * @return std::size_t The number of bits
+     */
+    std::size_t size() const { return bitCount; }
+
+    /**
+     * @brief Shrink or grow to `size` bits (new bits are 0)
+     *
+     * @param size The new number of bits
+     */
+    void resize(std::size_t size) {
+        words.resize((size + WORD_BITS - 1) / WORD_BITS, 0);
+        bitCount = size;
+        // Keep the unused tail of the last word zero so count() and forEachSetBit() ignore it
+        if (bitCount % WORD_BITS != 0) {
+            words.back() &= (std::uint64_t{ 1 } << (bitCount % WORD_BITS)) - 1;
+        }
+    }
+
+    /**
+     * @brief Reserve room for `size` bits
+     *
+     * @param size The expected number of bits
+     */
+    void reserve(std::size_t size) {
+        words.reserve((size + WORD_BITS - 1) / WORD_BITS);
+    }
+
+    /**
+     * @brief Remove all bits
+     */
+    void clear() {
+        words.clear();
+        bitCount = 0;
+    }
+
+    /**
+     * @brief Count the set bits
+     *
+     * @return std::size_t The number of set bits
+     */
+    std::size_t count() const {
+        std::size_t total = 0;
+        for (std::uint64_t word : words) {
+            total += static_cast<std::size_t>(__builtin_popcountll(word));
+        }
+        return total;
+    }
+
+    /**
+     * @brief Call `visit(position)` for every set bit, in ascending order
+     *
+     * @tparam Visitor Callable taking a std::size_t position
+     * @param visit The visitor
+     */
+    template <typename Visitor>
+    void forEachSetBit(Visitor visit) const {
+        for (std::size_t w = 0; w < words.size(); ++w) {
+            std::uint64_t word = words[w];
+            while (word != 0) {
+                const std::size_t bit = static_cast<std::size_t>(__builtin_ctzll(word));
+                visit(w * WORD_BITS + bit);
+                word &= word - 1; // Clear the lowest set bit
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t WORD_BITS = 64;
+
+    std::vector<std::uint64_t> words;   // Packed bits, WORD_BITS per word
+    std::size_t bitCount = 0;           // Number of bits in use
+};
+
+#endif // BITMAP_H
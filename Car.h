@@ -46,9 +46,9 @@ public:
     /**
      * @brief Get the type of the vehicle
      *
-     * @return std::string The type of the vehicle (Car)
+     * @return VehicleType The type of the vehicle (VehicleType::Car)
      */
-    std::string getType() const override { return "Car"; }
+    VehicleType getType() const override { return VehicleType::Car; }
 };
 
 #endif // CAR_H
\ No newline at end of file
@@ -23,16 +23,17 @@ int Customer::getCustomerID() const { return customerID; }
 /**
  * This function returns the name of the customer.
  *
- * @return The `name` member variable of the `Customer` class is being returned as a `std::string`.
+ * @return The `name` member variable of the `Customer` class is being returned by reference, without
+ * copying.
  */
-std::string Customer::getName() const { return name; }
+const std::string& Customer::getName() const { return name; }
 
 /**
- * This function returns a vector of RentalInfo objects representing vehicles rented by a customer.
+ * This function returns the vector of RentalInfo objects representing vehicles rented by a customer.
  *
- * @return A vector of RentalInfo objects representing the vehicles that the customer has rented.
+ * @return A reference to the customer's RentalInfo vector; no copy of the rentals is made.
  */
-std::vector<RentalInfo> Customer::getRentedVehicles() const { return rentedVehicles; }
+const std::vector<RentalInfo>& Customer::getRentedVehicles() const { return rentedVehicles; }
 
 /**
  * This function returns the loyalty points of a customer.
@@ -82,7 +83,7 @@ int Customer::returnVehicle(const std::shared_ptr<Vehicle>& vehicle, const std::
 
     // Find the rental information for the vehicle
     auto it = std::find_if(rentedVehicles.begin(), rentedVehicles.end(),
-                           [&](const RentalInfo& rental) { return rental.vehicle->getVehicleID() == vehicle->getVehicleID(); });
+                           [&](const RentalInfo& rental) { return rental.vehicle->hasSameID(*vehicle); });
 
     if (it != rentedVehicles.end()) {
         // Calculate days late
@@ -109,7 +110,7 @@ int Customer::returnVehicle(const std::shared_ptr<Vehicle>& vehicle, const std::
  */
 bool Customer::hasRentedVehicle(const std::shared_ptr<Vehicle>& vehicle) const {
     return std::any_of(rentedVehicles.begin(), rentedVehicles.end(),
-                       [&](const RentalInfo& rental) { return rental.vehicle->getVehicleID() == vehicle->getVehicleID(); });
+                       [&](const RentalInfo& rental) { return rental.vehicle->hasSameID(*vehicle); });
 }
 
 /**
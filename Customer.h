@@ -11,6 +11,10 @@
 #include <sstream>
 #include "Vehicle.h"
 
+// Range of customer IDs accepted by isValidCustomerID (3-digit numbers)
+constexpr int MIN_CUSTOMER_ID = 100;
+constexpr int MAX_CUSTOMER_ID = 999;
+
 // The `RentalInfo` struct represents information about a rental transaction.
 struct RentalInfo {
     std::shared_ptr<Vehicle> vehicle; // The rented vehicle
@@ -52,16 +56,16 @@ public:
     /**
      * @brief Get the name of the customer
      *
-     * @return std::string The name of the customer
+     * @return const std::string& The name of the customer
      */
-    std::string getName() const;
+    const std::string& getName() const;
 
     /**
      * @brief Get the list of rented vehicles
      *
-     * @return std::vector<RentalInfo> The list of rented vehicles
+     * @return const std::vector<RentalInfo>& The list of rented vehicles
      */
-    std::vector<RentalInfo> getRentedVehicles() const;
+    const std::vector<RentalInfo>& getRentedVehicles() const;
 
     /**
      * @brief Get the loyalty points of the customer
@@ -0,0 +1,321 @@
+// EditDistance.cpp
+#include "EditDistance.h"
+#include "Utils.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EDIT_DISTANCE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using MatchMasks = std::array<std::uint64_t, 256>;
+
+// Runs the bit-parallel kernel for the query against `Lanes` texts at once; unused lanes hold
+// empty views. Writes the unbounded distance of each lane to `out`.
+using LaneKernel = void (*)(const MatchMasks& peq, std::size_t m, const std::string_view* texts, std::size_t* out);
+
+/**
+ * Gather the match mask of column `j` for every lane. Lanes whose text is shorter than `j + 1`
+ * get an all-zero `active` mask so their score stops changing.
+ */
+template <std::size_t Lanes>
+void gatherColumn(const MatchMasks& peq, const std::string_view* texts, std::size_t j, std::uint64_t* eq, std::uint64_t* active) {
+    for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        const bool inText = j < texts[lane].size();
+        eq[lane] = inText ? peq[static_cast<unsigned char>(texts[lane][j])] : 0;
+        active[lane] = inText ? ~std::uint64_t{ 0 } : 0;
+    }
+}
+
+template <std::size_t Lanes>
+std::size_t longestText(const std::string_view* texts) {
+    std::size_t longest = 0;
+    for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        longest = std::max(longest, texts[lane].size());
+    }
+    return longest;
+}
+
+#ifdef EDIT_DISTANCE_X86
+
+// Two texts per step in 64-bit SSE2 lanes (SSE2 is part of the x86-64 baseline)
+void sse2Lanes(const MatchMasks& peq, std::size_t m, const std::string_view* texts, std::size_t* out) {
+    alignas(16) std::uint64_t eqLanes[2];
+    alignas(16) std::uint64_t activeLanes[2];
+    const __m128i ones = _mm_set1_epi64x(-1);
+    const __m128i one = _mm_set1_epi64x(1);
+    const __m128i shift = _mm_cvtsi64_si128(static_cast<long long>(m - 1));
+    __m128i pv = ones;
+    __m128i mv = _mm_setzero_si128();
+    __m128i score = _mm_set1_epi64x(static_cast<long long>(m));
+
+    const std::size_t columns = longestText<2>(texts);
+    for (std::size_t j = 0; j < columns; ++j) {
+        gatherColumn<2>(peq, texts, j, eqLanes, activeLanes);
+        const __m128i eq = _mm_load_si128(reinterpret_cast<const __m128i*>(eqLanes));
+        const __m128i active = _mm_load_si128(reinterpret_cast<const __m128i*>(activeLanes));
+
+        const __m128i xv = _mm_or_si128(eq, mv);
+        const __m128i xh = _mm_or_si128(_mm_xor_si128(_mm_add_epi64(_mm_and_si128(eq, pv), pv), pv), eq);
+        __m128i ph = _mm_or_si128(mv, _mm_andnot_si128(_mm_or_si128(xh, pv), ones));
+        __m128i mh = _mm_and_si128(pv, xh);
+
+        const __m128i up = _mm_and_si128(_mm_and_si128(_mm_srl_epi64(ph, shift), one), active);
+        const __m128i down = _mm_and_si128(_mm_and_si128(_mm_srl_epi64(mh, shift), one), active);
+        score = _mm_sub_epi64(_mm_add_epi64(score, up), down);
+
+        ph = _mm_or_si128(_mm_slli_epi64(ph, 1), one);
+        mh = _mm_slli_epi64(mh, 1);
+        pv = _mm_or_si128(mh, _mm_andnot_si128(_mm_or_si128(xv, ph), ones));
+        mv = _mm_and_si128(ph, xv);
+    }
+
+    alignas(16) std::uint64_t scores[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(scores), score);
+    out[0] = static_cast<std::size_t>(scores[0]);
+    out[1] = static_cast<std::size_t>(scores[1]);
+}
+
+// Four texts per step in 64-bit AVX2 lanes
+__attribute__((target("avx2")))
+void avx2Lanes(const MatchMasks& peq, std::size_t m, const std::string_view* texts, std::size_t* out) {
+    alignas(32) std::uint64_t eqLanes[4];
+    alignas(32) std::uint64_t activeLanes[4];
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m128i shift = _mm_cvtsi64_si128(static_cast<long long>(m - 1));
+    __m256i pv = ones;
+    __m256i mv = _mm256_setzero_si256();
+    __m256i score = _mm256_set1_epi64x(static_cast<long long>(m));
+
+    const std::size_t columns = longestText<4>(texts);
+    for (std::size_t j = 0; j < columns; ++j) {
+        gatherColumn<4>(peq, texts, j, eqLanes, activeLanes);
+        const __m256i eq = _mm256_load_si256(reinterpret_cast<const __m256i*>(eqLanes));
+        const __m256i active = _mm256_load_si256(reinterpret_cast<const __m256i*>(activeLanes));
+
+        const __m256i xv = _mm256_or_si256(eq, mv);
+        const __m256i xh = _mm256_or_si256(_mm256_xor_si256(_mm256_add_epi64(_mm256_and_si256(eq, pv), pv), pv), eq);
+        __m256i ph = _mm256_or_si256(mv, _mm256_andnot_si256(_mm256_or_si256(xh, pv), ones));
+        __m256i mh = _mm256_and_si256(pv, xh);
+
+        const __m256i up = _mm256_and_si256(_mm256_and_si256(_mm256_srl_epi64(ph, shift), one), active);
+        const __m256i down = _mm256_and_si256(_mm256_and_si256(_mm256_srl_epi64(mh, shift), one), active);
+        score = _mm256_sub_epi64(_mm256_add_epi64(score, up), down);
+
+        ph = _mm256_or_si256(_mm256_slli_epi64(ph, 1), one);
+        mh = _mm256_slli_epi64(mh, 1);
+        pv = _mm256_or_si256(mh, _mm256_andnot_si256(_mm256_or_si256(xv, ph), ones));
+        mv = _mm256_and_si256(ph, xv);
+    }
+
+    alignas(32) std::uint64_t scores[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(scores), score);
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+        out[lane] = static_cast<std::size_t>(scores[lane]);
+    }
+}
+
+#else
+
+// One text at a time where no SIMD kernel is available
+void scalarLanes(const MatchMasks& peq, std::size_t m, const std::string_view* texts, std::size_t* out) {
+    const std::uint64_t last = std::uint64_t{ 1 } << (m - 1);
+    std::uint64_t pv = ~std::uint64_t{ 0 };
+    std::uint64_t mv = 0;
+    std::size_t score = m;
+    for (char c : texts[0]) {
+        const std::uint64_t eq = peq[static_cast<unsigned char>(c)];
+        const std::uint64_t xv = eq | mv;
+        const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+        if (ph & last) {
+            ++score;
+        } else if (mh & last) {
+            --score;
+        }
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    out[0] = score;
+}
+
+#endif // EDIT_DISTANCE_X86
+
+struct KernelChoice {
+    LaneKernel kernel;
+    std::size_t lanes;
+    std::string_view name;
+};
+
+const KernelChoice& selectedKernel() {
+    static const KernelChoice choice = [] {
+#ifdef EDIT_DISTANCE_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return KernelChoice{ avx2Lanes, 4, "avx2" };
+        }
+        return KernelChoice{ sse2Lanes, 2, "sse2" };
+#else
+        return KernelChoice{ scalarLanes, 1, "scalar" };
+#endif
+    }();
+    return choice;
+}
+
+} // namespace
+
+/**
+ * The function `boundedLevenshteinDistances` compares `query` with every string in `texts`. Texts
+ * whose length differs from the query's by more than `maxDistance` are rejected up front; the rest
+ * are packed into groups of SIMD lanes that share the query's match-mask table and run the
+ * bit-parallel recurrence side by side, each lane freezing its score once its own text ends. Queries
+ * longer than 64 characters do not fit a lane and are handled one text at a time.
+ *
+ * @param query The `query` parameter is the string being searched for.
+ * @param texts The `texts` parameter holds the strings to compare it with.
+ * @param maxDistance The `maxDistance` parameter is the search threshold.
+ * @param distances The `distances` parameter receives, for each text, its distance from the query
+ * if that is at most `maxDistance`, otherwise `maxDistance + 1`.
+ */
+void boundedLevenshteinDistances(std::string_view query, const std::vector<std::string_view>& texts,
+                                 std::size_t maxDistance, std::vector<std::size_t>& distances) {
+    distances.resize(texts.size());
+    if (query.empty() || query.size() > 64) {
+        for (std::size_t i = 0; i < texts.size(); ++i) {
+            distances[i] = boundedLevenshteinDistance(query, texts[i], maxDistance);
+        }
+        return;
+    }
+
+    MatchMasks peq{};
+    for (std::size_t i = 0; i < query.size(); ++i) {
+        peq[static_cast<unsigned char>(query[i])] |= std::uint64_t{ 1 } << i;
+    }
+
+    const KernelChoice& choice = selectedKernel();
+    std::array<std::string_view, 4> laneTexts;
+    std::array<std::size_t, 4> laneIndex{};
+    std::array<std::size_t, 4> laneScore{};
+    std::size_t filled = 0;
+
+    auto flush = [&] {
+        for (std::size_t lane = filled; lane < choice.lanes; ++lane) {
+            laneTexts[lane] = std::string_view();
+        }
+        choice.kernel(peq, query.size(), laneTexts.data(), laneScore.data());
+        for (std::size_t lane = 0; lane < filled; ++lane) {
+            distances[laneIndex[lane]] = laneScore[lane] <= maxDistance ? laneScore[lane] : maxDistance + 1;
+        }
+        filled = 0;
+    };
+
+    for (std::size_t i = 0; i < texts.size(); ++i) {
+        const std::size_t length = texts[i].size();
+        const std::size_t lengthGap = length > query.size() ? length - query.size() : query.size() - length;
+        if (lengthGap > maxDistance) {
+            distances[i] = maxDistance + 1;
+            continue;
+        }
+        laneTexts[filled] = texts[i];
+        laneIndex[filled] = i;
+        if (++filled == choice.lanes) {
+            flush();
+        }
+    }
+    if (filled > 0) {
+        flush();
+    }
+}
+
+/**
+ * The function `batchEditDistanceKernel` reports which lane kernel `boundedLevenshteinDistances`
+ * uses on this machine.
+ *
+ * @return "avx2", "sse2" or "scalar".
+ */
+std::string_view batchEditDistanceKernel() {
+    return selectedKernel().name;
+}
+
+/**
+ * The constructor `SymbolMatchCache` records the query and threshold; verdicts are computed lazily.
+ *
+ * @param text The `text` parameter is the string being searched for.
+ * @param threshold The `threshold` parameter is the largest edit distance that counts as a match.
+ */
+SymbolMatchCache::SymbolMatchCache(std::string_view text, std::size_t threshold)
+    : query(text), maxDistance(threshold) {}
+
+/**
+ * The function `prime` collects the symbols in `symbols` whose distance is not known yet (each only
+ * once) and compares them with the query in a single batched call.
+ *
+ * @param symbols The `symbols` parameter is the list of symbols to evaluate; it may repeat symbols.
+ */
+void SymbolMatchCache::prime(const std::vector<Symbol>& symbols) {
+    const SymbolTable& table = SymbolTable::global();
+    std::vector<Symbol> pending;
+    std::vector<std::string_view> texts;
+    for (Symbol symbol : symbols) {
+        std::size_t& slot = slotOf(symbol);
+        if (slot == UNKNOWN) {
+            slot = PENDING;
+            pending.push_back(symbol);
+            texts.push_back(table.text(symbol));
+        }
+    }
+
+    std::vector<std::size_t> results;
+    boundedLevenshteinDistances(query, texts, maxDistance, results);
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        distances[pending[i]] = results[i];
+    }
+    evaluatedCount += pending.size();
+}
+
+/**
+ * The function `matches` checks the cached distance of `symbol` against the threshold, computing
+ * the distance the first time the symbol is seen.
+ *
+ * @param symbol The `symbol` parameter is the interned value to check.
+ *
+ * @return True if the symbol's text is within `maxDistance` edits of the query.
+ */
+bool SymbolMatchCache::matches(Symbol symbol) {
+    return distance(symbol) <= maxDistance;
+}
+
+/**
+ * The function `distance` returns the cached bounded distance from the query to `symbol`'s text,
+ * computing it the first time the symbol is seen.
+ *
+ * @param symbol The `symbol` parameter is the interned value to measure.
+ *
+ * @return The distance if it is at most `maxDistance`, otherwise `maxDistance + 1`.
+ */
+std::size_t SymbolMatchCache::distance(Symbol symbol) {
+    std::size_t& slot = slotOf(symbol);
+    if (slot == UNKNOWN || slot == PENDING) {
+        slot = boundedLevenshteinDistance(query, SymbolTable::global().text(symbol), maxDistance);
+        ++evaluatedCount;
+    }
+    return slot;
+}
+
+/**
+ * The function `slotOf` returns the cache slot for `symbol`, growing the table as needed.
+ */
+std::size_t& SymbolMatchCache::slotOf(Symbol symbol) {
+    if (symbol >= distances.size()) {
+        distances.resize(static_cast<std::size_t>(symbol) + 1, UNKNOWN);
+    }
+    return distances[symbol];
+}
@@ -0,0 +1,93 @@
+// EditDistance.h
+#ifndef EDITDISTANCE_H
+#define EDITDISTANCE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "SymbolTable.h"
+
+/**
+ * @brief Calculate the bounded Levenshtein distance from one query to many strings at once
+ *
+ * Equivalent to calling boundedLevenshteinDistance(query, texts[i], maxDistance) for every `i`, but
+ * when the query is at most 64 characters the candidates that pass the length check are processed
+ * several at a time, one per SIMD lane, with the bit-parallel kernel. The instruction set (AVX2,
+ * SSE2 or plain scalar code) is chosen once at runtime from what the CPU supports.
+ *
+ * @param query The query string
+ * @param texts The strings to compare the query against
+ * @param maxDistance The largest distance of interest
+ * @param distances Receives one entry per text: the distance if it is at most maxDistance, otherwise maxDistance + 1
+ */
+void boundedLevenshteinDistances(std::string_view query, const std::vector<std::string_view>& texts,
+                                 std::size_t maxDistance, std::vector<std::size_t>& distances);
+
+/**
+ * @brief Get the name of the batch kernel selected for this CPU
+ *
+ * @return std::string_view "avx2", "sse2" or "scalar"
+ */
+std::string_view batchEditDistanceKernel();
+
+// The `SymbolMatchCache` class memoises, for a single fuzzy query, the bounded edit distance from
+// the query to each interned value (a vehicle make or model) and hence whether it is within the
+// query's threshold. Thousands of vehicles share a handful of makes, so a search that consults the
+// cache computes one distance per distinct value instead of one per vehicle. The cache is meant to
+// live for one query only.
+class SymbolMatchCache {
+public:
+    /**
+     * @brief Construct a cache for one query
+     *
+     * @param text The query string
+     * @param threshold The largest edit distance that counts as a match
+     */
+    SymbolMatchCache(std::string_view text, std::size_t threshold);
+
+    /**
+     * @brief Work out the verdicts of several symbols at once with the batched kernel
+     *
+     * Symbols already known (or repeated in `symbols`) are compared only once.
+     *
+     * @param symbols The symbols to evaluate
+     */
+    void prime(const std::vector<Symbol>& symbols);
+
+    /**
+     * @brief Check whether a symbol's text is within the threshold, computing it on first use
+     *
+     * @param symbol The symbol to check
+     * @return bool True if the symbol matches the query
+     */
+    bool matches(Symbol symbol);
+
+    /**
+     * @brief Get a symbol's bounded distance from the query, computing it on first use
+     *
+     * @param symbol The symbol to measure
+     * @return std::size_t The distance if it is at most maxDistance, otherwise maxDistance + 1
+     */
+    std::size_t distance(Symbol symbol);
+
+    /**
+     * @brief Get the number of distances computed so far
+     *
+     * @return std::size_t The number of distinct symbols evaluated
+     */
+    std::size_t evaluated() const { return evaluatedCount; }
+
+private:
+    static constexpr std::size_t UNKNOWN = static_cast<std::size_t>(-1);     // Not seen yet
+    static constexpr std::size_t PENDING = static_cast<std::size_t>(-2);     // Queued by prime()
+
+    std::size_t& slotOf(Symbol symbol);
+
+    std::string query;                  // The query string
+    std::size_t maxDistance;            // The match threshold
+    std::vector<std::size_t> distances; // Symbol -> bounded distance, UNKNOWN or PENDING
+    std::size_t evaluatedCount = 0;     // Distances computed
+};
+
+#endif // EDITDISTANCE_H
@@ -0,0 +1,156 @@
+// Handle.h
+#ifndef HANDLE_H
+#define HANDLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// The `Handle` struct is a stable reference to an item stored in a Repository. It names a slot in
+// the repository's HandleTable together with the generation the slot had when the handle was
+// issued. Removing the item bumps the slot's generation, so an old handle can be detected as stale
+// instead of silently pointing at whatever item re-uses the slot.
+struct Handle {
+    static constexpr std::uint32_t INVALID_SLOT = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t slot = INVALID_SLOT;  // Slot in the HandleTable
+    std::uint32_t generation = 0;       // Generation of the slot when the handle was issued
+
+    /**
+     * @brief Check whether the handle was ever issued (it may still be stale)
+     *
+     * @return bool True if the handle refers to a slot, false for a default-constructed handle
+     */
+    bool isValid() const { return slot != INVALID_SLOT; }
+};
+
+// The `HandleTable` class maps stable handles onto the positions of items in a densely packed
+// vector. The owning repository reports every push, move and removal of a position so that items
+// can be swapped around freely (e.g. swap-and-pop removal) without invalidating handles.
+class HandleTable {
+public:
+    static constexpr std::size_t NPOS = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Issue a handle for an item that has just been appended at `position`
+     *
+     * @param position The position of the new item (must equal the current item count)
+     * @return Handle The handle for the item
+     */
+    Handle attach(std::size_t position) {
+        std::uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<std::uint32_t>(slots.size());
+            slots.push_back(Slot{});
+        }
+        slots[slot].position = static_cast<std::uint32_t>(position);
+        slotOfPosition.push_back(slot);
+        return Handle{ slot, slots[slot].generation };
+    }
+
+    /**
+     * @brief Invalidate the handle of the item at `position`
+     *
+     * The position itself stays reserved until it is overwritten by move() or dropped by truncate().
+     *
+     * @param position The position of the item being removed
+     */
+    void detach(std::size_t position) {
+        const std::uint32_t slot = slotOfPosition[position];
+        slots[slot].position = FREE;
+        ++slots[slot].generation;
+        freeSlots.push_back(slot);
+    }
+
+    /**
+     * @brief Record that the item at `from` has been moved to `to`
+     *
+     * @param from The old position of the item
+     * @param to The new position of the item
+     */
+    void move(std::size_t from, std::size_t to) {
+        const std::uint32_t slot = slotOfPosition[from];
+        slots[slot].position = static_cast<std::uint32_t>(to);
+        slotOfPosition[to] = slot;
+    }
+
+    /**
+     * @brief Drop all positions from `size` onwards (their handles must already be detached or moved)
+     *
+     * @param size The new number of items
+     */
+    void truncate(std::size_t size) {
+        slotOfPosition.resize(size);
+    }
+
+    /**
+     * @brief Get the handle of the item at `position`
+     *
+     * @param position The position of the item
+     * @return Handle The handle of the item
+     */
+    Handle handleAt(std::size_t position) const {
+        const std::uint32_t slot = slotOfPosition[position];
+        return Handle{ slot, slots[slot].generation };
+    }
+
+    /**
+     * @brief Resolve a handle to the current position of its item
+     *
+     * @param handle The handle to resolve
+     * @return std::size_t The item's position, or NPOS if the handle is stale or invalid
+     */
+    std::size_t positionOf(const Handle& handle) const {
+        if (handle.slot >= slots.size()) {
+            return NPOS;
+        }
+        const Slot& entry = slots[handle.slot];
+        if (entry.generation != handle.generation || entry.position == FREE) {
+            return NPOS;
+        }
+        return entry.position;
+    }
+
+    /**
+     * @brief Invalidate every handle and forget all positions
+     */
+    void clear() {
+        freeSlots.clear();
+        for (std::uint32_t slot = 0; slot < slots.size(); ++slot) {
+            if (slots[slot].position != FREE) {
+                slots[slot].position = FREE;
+                ++slots[slot].generation;
+            }
+            freeSlots.push_back(slot);
+        }
+        slotOfPosition.clear();
+    }
+
+    /**
+     * @brief Reserve room for `count` items
+     *
+     * @param count The expected number of items
+     */
+    void reserve(std::size_t count) {
+        slotOfPosition.reserve(count);
+        slots.reserve(count);
+    }
+
+private:
+    static constexpr std::uint32_t FREE = std::numeric_limits<std::uint32_t>::max();
+
+    struct Slot {
+        std::uint32_t position = FREE;  // Position of the item, or FREE if the slot is unused
+        std::uint32_t generation = 0;   // Bumped every time the slot's item is removed
+    };
+
+    std::vector<Slot> slots;                    // Slot -> position and generation
+    std::vector<std::uint32_t> slotOfPosition;  // Position -> slot
+    std::vector<std::uint32_t> freeSlots;       // Slots available for re-use
+};
+
+#endif // HANDLE_H
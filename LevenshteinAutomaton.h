@@ -0,0 +1,88 @@
+// LevenshteinAutomaton.h
+#ifndef LEVENSHTEINAUTOMATON_H
+#define LEVENSHTEINAUTOMATON_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// The `LevenshteinAutomaton` class accepts exactly the strings within `maxDistance` edits of a
+// query. Its state after reading a prefix is the matching row of the edit-distance table: entry `j`
+// is the distance from that prefix to the first `j` characters of the query. Reading one more
+// character computes the next row from the current one, so the automaton can be run along the paths
+// of a trie, sharing the work for common prefixes. Once every entry of a row exceeds the threshold
+// no continuation can be accepted, which is what lets a trie walk skip whole subtrees.
+//
+// States are plain arrays of stateSize() entries owned by the caller, so a depth-first walk can keep
+// one row per depth in a single buffer.
+class LevenshteinAutomaton {
+public:
+    /**
+     * @brief Construct the automaton for one query
+     *
+     * @param query The query string
+     * @param maxDistance The largest edit distance to accept
+     */
+    LevenshteinAutomaton(std::string_view query, std::size_t maxDistance)
+        : pattern(query), threshold(maxDistance) {}
+
+    /**
+     * @brief Get the number of entries in a state
+     *
+     * @return std::size_t The query length plus one
+     */
+    std::size_t stateSize() const { return pattern.size() + 1; }
+
+    /**
+     * @brief Write the state for the empty prefix
+     *
+     * @param state Receives stateSize() entries
+     */
+    void start(std::size_t* state) const {
+        for (std::size_t j = 0; j <= pattern.size(); ++j) {
+            state[j] = j;
+        }
+    }
+
+    /**
+     * @brief Read one character
+     *
+     * @param from The current state
+     * @param c The character read
+     * @param to Receives the next state (must not overlap `from`)
+     * @return bool True if some continuation of the new prefix can still be accepted
+     */
+    bool step(const std::size_t* from, char c, std::size_t* to) const {
+        to[0] = from[0] + 1;
+        std::size_t best = to[0];
+        for (std::size_t j = 1; j <= pattern.size(); ++j) {
+            const std::size_t substitute = from[j - 1] + (pattern[j - 1] == c ? 0 : 1);
+            to[j] = std::min({ from[j] + 1, to[j - 1] + 1, substitute });
+            best = std::min(best, to[j]);
+        }
+        return best <= threshold;
+    }
+
+    /**
+     * @brief Check whether the prefix read so far is itself accepted
+     *
+     * @param state The current state
+     * @return bool True if the prefix is within the threshold of the query
+     */
+    bool accepts(const std::size_t* state) const { return state[pattern.size()] <= threshold; }
+
+    /**
+     * @brief Get the edit distance from the prefix read so far to the query
+     *
+     * @param state The current state
+     * @return std::size_t The exact distance
+     */
+    std::size_t distance(const std::size_t* state) const { return state[pattern.size()]; }
+
+private:
+    std::string pattern;        // The query
+    std::size_t threshold;      // The largest accepted distance
+};
+
+#endif // LEVENSHTEINAUTOMATON_H
@@ -0,0 +1,112 @@
+// LruCache.h
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// The `LruCache` class is a fixed-capacity map that evicts the least recently used entry when it is
+// full. Entries live in a list ordered from most to least recently used, and a hash map from key to
+// list position makes lookup, promotion and eviction O(1). A capacity of 0 disables the cache.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+    /**
+     * @brief Construct an empty cache
+     *
+     * @param capacity The maximum number of entries
+     */
+    explicit LruCache(std::size_t capacity) : maxEntries(capacity) {}
+
+    /**
+     * @brief Look up an entry and mark it most recently used
+     *
+     * @param key The key to look up
+     * @return const Value* The cached value, or nullptr if the key is not cached
+     */
+    const Value* find(const Key& key) {
+        auto it = lookup.find(key);
+        if (it == lookup.end()) {
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->second;
+    }
+
+    /**
+     * @brief Insert or replace an entry as the most recently used, evicting the least recently used if full
+     *
+     * @param key The key
+     * @param value The value
+     */
+    void put(const Key& key, Value value) {
+        if (maxEntries == 0) {
+            return;
+        }
+        auto it = lookup.find(key);
+        if (it != lookup.end()) {
+            it->second->second = std::move(value);
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+        if (entries.size() == maxEntries) {
+            lookup.erase(entries.back().first);
+            entries.pop_back();
+        }
+        entries.emplace_front(key, std::move(value));
+        lookup.emplace(key, entries.begin());
+    }
+
+    /**
+     * @brief Visit every entry from most to least recently used, without changing the order
+     *
+     * @tparam Visit Callable taking (const Key&, const Value&)
+     * @param visit The visitor
+     */
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (const auto& entry : entries) {
+            visit(entry.first, entry.second);
+        }
+    }
+
+    /**
+     * @brief Change the capacity, evicting least recently used entries if there are too many
+     *
+     * @param capacity The new maximum number of entries
+     */
+    void setCapacity(std::size_t capacity) {
+        maxEntries = capacity;
+        while (entries.size() > maxEntries) {
+            lookup.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+    /**
+     * @brief Remove every entry
+     */
+    void clear() {
+        entries.clear();
+        lookup.clear();
+    }
+
+    /**
+     * @brief Get the number of cached entries
+     *
+     * @return std::size_t The entry count
+     */
+    std::size_t size() const { return entries.size(); }
+
+private:
+    using Entry = std::pair<Key, Value>;
+
+    std::list<Entry> entries;                                                   // Most recently used first
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> lookup;  // Key -> entry
+    std::size_t maxEntries;                                                     // Capacity
+};
+
+#endif // LRUCACHE_H
@@ -46,9 +46,9 @@ public:
     /**
      * @brief Get the type of the vehicle
      *
-     * @return std::string The type of the vehicle (Minibus)
+     * @return VehicleType The type of the vehicle (VehicleType::Minibus)
      */
-    std::string getType() const override { return "Minibus"; }
+    VehicleType getType() const override { return VehicleType::Minibus; }
 };
 
 #endif // MINIBUS_H
\ No newline at end of file
@@ -0,0 +1,43 @@
+// ObjectPool.cpp
+#include "ObjectPool.h"
+
+namespace {
+
+/**
+ * Registry of the release functions of all arenas created so far. Function-local so it is
+ * constructed before the first arena registers itself.
+ */
+std::vector<bool (*)()>& arenaRegistry() {
+    static std::vector<bool (*)()> registry;
+    return registry;
+}
+
+} // namespace
+
+/**
+ * The function `registerArena` records an arena's release function so that `releaseUnused` can
+ * reach it later. Each `SlabArena` registers itself from its constructor.
+ *
+ * @param release The `release` parameter is a function that frees the arena's slabs and returns
+ * `true` if the arena held no live objects.
+ */
+void ObjectPools::registerArena(bool (*release)()) {
+    arenaRegistry().push_back(release);
+}
+
+/**
+ * The function `releaseUnused` returns the slabs of every empty arena to the heap in one sweep.
+ * Arenas that still have live objects (for example a vehicle still referenced outside the
+ * repositories) keep their slabs and are released on a later call.
+ *
+ * @return The number of arenas whose slabs were released.
+ */
+std::size_t ObjectPools::releaseUnused() {
+    std::size_t released = 0;
+    for (auto release : arenaRegistry()) {
+        if (release()) {
+            ++released;
+        }
+    }
+    return released;
+}
@@ -0,0 +1,177 @@
+// ObjectPool.h
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// The `ObjectPools` class is the registry of every SlabArena in the program, so that all of them
+// can be released together (RentalCompany::clearData does this once the repositories are empty).
+class ObjectPools {
+public:
+    /**
+     * @brief Register an arena's release function (called once per arena, on first use)
+     *
+     * @param release Function that frees the arena's slabs if it has no live objects
+     */
+    static void registerArena(bool (*release)());
+
+    /**
+     * @brief Free the slabs of every arena that no longer holds any live object
+     *
+     * @return std::size_t The number of arenas released
+     */
+    static std::size_t releaseUnused();
+};
+
+// The `SlabArena` class is a typed fixed-size allocator: it carves blocks for objects of type T out
+// of large slabs, so objects of one type sit contiguously in memory and cost one heap allocation
+// per SLAB_BLOCKS objects instead of one each. Freed blocks go onto an intrusive free list for
+// re-use; the slabs themselves are returned to the heap wholesale by release(). Not thread-safe:
+// objects are created and destroyed on the thread that owns the RentalCompany.
+template <typename T>
+class SlabArena {
+public:
+    static constexpr std::size_t SLAB_BLOCKS = 1024;
+
+    /**
+     * @brief Get the arena for type T
+     *
+     * @return SlabArena& The arena
+     */
+    static SlabArena& instance() {
+        static SlabArena arena;
+        return arena;
+    }
+
+    /**
+     * @brief Allocate uninitialised storage for one T
+     *
+     * @return T* Pointer to the storage
+     */
+    T* allocate() {
+        if (freeList == nullptr) {
+            grow();
+        }
+        Block* block = freeList;
+        freeList = block->next;
+        ++liveBlocks;
+        return reinterpret_cast<T*>(block);
+    }
+
+    /**
+     * @brief Return storage obtained from allocate() (the object must already be destroyed)
+     *
+     * @param object Pointer to the storage
+     */
+    void deallocate(T* object) {
+        Block* block = reinterpret_cast<Block*>(object);
+        block->next = freeList;
+        freeList = block;
+        --liveBlocks;
+    }
+
+    /**
+     * @brief Free every slab if no object is live
+     *
+     * @return bool True if the slabs were freed (or there were none), false if objects are still live
+     */
+    bool release() {
+        if (liveBlocks != 0) {
+            return false;
+        }
+        slabs.clear();
+        freeList = nullptr;
+        return true;
+    }
+
+    /**
+     * @brief Get the number of live objects
+     *
+     * @return std::size_t The number of blocks handed out and not yet returned
+     */
+    std::size_t liveCount() const { return liveBlocks; }
+
+    /**
+     * @brief Get the number of slabs currently held
+     *
+     * @return std::size_t The number of slabs
+     */
+    std::size_t slabCount() const { return slabs.size(); }
+
+private:
+    union Block {
+        Block* next;                                    // Next free block while unused
+        alignas(T) unsigned char storage[sizeof(T)];    // Object storage while in use
+    };
+
+    SlabArena() {
+        ObjectPools::registerArena([]() { return instance().release(); });
+    }
+
+    void grow() {
+        slabs.emplace_back(new Block[SLAB_BLOCKS]);
+        Block* slab = slabs.back().get();
+        for (std::size_t i = SLAB_BLOCKS; i-- > 0;) {
+            slab[i].next = freeList;
+            freeList = &slab[i];
+        }
+    }
+
+    std::vector<std::unique_ptr<Block[]>> slabs;    // Slabs of SLAB_BLOCKS blocks each
+    Block* freeList = nullptr;                      // Free blocks across all slabs
+    std::size_t liveBlocks = 0;                     // Blocks currently handed out
+};
+
+// The `PoolAllocator` class adapts SlabArena to the standard allocator interface. Used with
+// std::allocate_shared it is rebound to the shared_ptr control block type, so each object and its
+// reference counts share one block in the arena for that concrete type.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return SlabArena<T>::instance().allocate();
+    }
+
+    void deallocate(T* object, std::size_t n) noexcept {
+        if (n != 1) {
+            ::operator delete(object);
+            return;
+        }
+        SlabArena<T>::instance().deallocate(object);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept { return true; }
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept { return false; }
+
+/**
+ * @brief Create a shared object in the slab arena for its type (drop-in for std::make_shared)
+ *
+ * @tparam T The type of the object
+ * @tparam Args The constructor argument types
+ * @param args The constructor arguments
+ * @return std::shared_ptr<T> The new object
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> makePooled(Args&&... args) {
+    return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+#endif // OBJECTPOOL_H
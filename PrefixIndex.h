@@ -0,0 +1,204 @@
+// PrefixIndex.h
+#ifndef PREFIXINDEX_H
+#define PREFIXINDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// One autocomplete suggestion: a complete text and how many items have it
+struct Completion {
+    std::string text;       // The completed text
+    std::size_t count;      // Number of items indexed under it
+};
+
+// The `PrefixIndex` class is a character trie over a multiset of texts (a vehicle's make, a
+// customer's name...) for autocomplete. Every node keeps the MAX_COMPLETIONS most frequent texts
+// in its subtree, best first, so complete() only walks down the prefix and copies that list: its
+// cost depends on the prefix length, not on how many texts share the prefix. Ties are broken
+// alphabetically. Matching is case-sensitive, like the searches the completions feed into.
+//
+// Adding an occurrence of a text can only move that text up, so each node on its path updates its
+// list in place. Removing one can let a text that was not listed overtake it, so a node whose list
+// is full is rebuilt from its children's lists, deepest node first. Nodes whose count drops to zero
+// stay in the trie and are reused if the text comes back.
+class PrefixIndex {
+public:
+    static constexpr std::size_t MAX_COMPLETIONS = 10;
+
+    PrefixIndex() : nodes(1) {}
+
+    /**
+     * @brief Add one occurrence of `text`
+     *
+     * @param text The text to add
+     */
+    void insert(std::string_view text) {
+        std::vector<std::uint32_t> path = walk(text, true);
+        const std::uint32_t leaf = path.back();
+        if (nodes[leaf].count++ == 0) {
+            nodes[leaf].term.assign(text.data(), text.size());
+        }
+        for (std::uint32_t node : path) {
+            promote(node, leaf);
+        }
+    }
+
+    /**
+     * @brief Remove one occurrence of `text` (no-op if it is not indexed)
+     *
+     * @param text The text to remove
+     */
+    void erase(std::string_view text) {
+        std::vector<std::uint32_t> path = walk(text, false);
+        if (path.empty() || nodes[path.back()].count == 0) {
+            return;
+        }
+        const std::uint32_t leaf = path.back();
+        --nodes[leaf].count;
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            demote(*it, leaf);
+        }
+    }
+
+    /**
+     * @brief Get the most frequent texts starting with `prefix`
+     *
+     * @param prefix The prefix typed so far
+     * @param limit The number of completions wanted (at most MAX_COMPLETIONS are kept)
+     * @return std::vector<Completion> Up to `limit` completions, most frequent first
+     */
+    std::vector<Completion> complete(std::string_view prefix, std::size_t limit = MAX_COMPLETIONS) const {
+        std::vector<Completion> completions;
+        std::uint32_t node = 0;
+        for (char c : prefix) {
+            node = child(node, c);
+            if (node == NONE) {
+                return completions;
+            }
+        }
+        const auto& top = nodes[node].top;
+        const std::size_t count = std::min(limit, top.size());
+        completions.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            completions.push_back(Completion{ nodes[top[i]].term, nodes[top[i]].count });
+        }
+        return completions;
+    }
+
+    /**
+     * @brief Remove all texts
+     */
+    void clear() {
+        nodes.assign(1, Node{});
+    }
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        std::vector<std::pair<char, std::uint32_t>> children;   // (character, node), sorted by character
+        std::size_t count = 0;                                  // Occurrences of the text ending here
+        std::string term;                                       // The text ending here (once inserted)
+        std::vector<std::uint32_t> top;                         // Best texts in the subtree, as end nodes
+    };
+
+    std::uint32_t child(std::uint32_t node, char c) const {
+        const auto& children = nodes[node].children;
+        auto it = std::lower_bound(children.begin(), children.end(), c,
+                                   [](const std::pair<char, std::uint32_t>& entry, char key) { return entry.first < key; });
+        return (it != children.end() && it->first == c) ? it->second : NONE;
+    }
+
+    // The nodes from the root to the end of `text`, creating them if asked (empty if absent)
+    std::vector<std::uint32_t> walk(std::string_view text, bool create) {
+        std::vector<std::uint32_t> path;
+        path.reserve(text.size() + 1);
+        path.push_back(0);
+        for (char c : text) {
+            std::uint32_t next = child(path.back(), c);
+            if (next == NONE) {
+                if (!create) {
+                    return {};
+                }
+                next = static_cast<std::uint32_t>(nodes.size());
+                auto& children = nodes[path.back()].children;
+                auto at = std::lower_bound(children.begin(), children.end(), c,
+                                           [](const std::pair<char, std::uint32_t>& entry, char key) { return entry.first < key; });
+                children.emplace(at, c, next);
+                nodes.emplace_back();
+            }
+            path.push_back(next);
+        }
+        return path;
+    }
+
+    // True if end node `a` ranks before end node `b`
+    bool ranksBefore(std::uint32_t a, std::uint32_t b) const {
+        return nodes[a].count != nodes[b].count ? nodes[a].count > nodes[b].count : nodes[a].term < nodes[b].term;
+    }
+
+    // `leaf`'s count went up: move it up `node`'s list, or into it if it now beats the last entry
+    void promote(std::uint32_t node, std::uint32_t leaf) {
+        auto& top = nodes[node].top;
+        auto it = std::find(top.begin(), top.end(), leaf);
+        if (it == top.end()) {
+            if (top.size() == MAX_COMPLETIONS && !ranksBefore(leaf, top.back())) {
+                return;
+            }
+            if (top.size() == MAX_COMPLETIONS) {
+                top.pop_back();
+            }
+            top.push_back(leaf);
+            it = top.end() - 1;
+        }
+        for (; it != top.begin() && ranksBefore(*it, *(it - 1)); --it) {
+            std::iter_swap(it, it - 1);
+        }
+    }
+
+    // `leaf`'s count went down: move it down `node`'s list, or rebuild a full list from the children
+    void demote(std::uint32_t node, std::uint32_t leaf) {
+        auto& top = nodes[node].top;
+        auto it = std::find(top.begin(), top.end(), leaf);
+        if (it == top.end()) {
+            return;
+        }
+        if (top.size() == MAX_COMPLETIONS) {
+            rebuild(node);
+            return;
+        }
+        if (nodes[leaf].count == 0) {
+            top.erase(it);
+            return;
+        }
+        for (; it + 1 != top.end() && ranksBefore(*(it + 1), *it); ++it) {
+            std::iter_swap(it, it + 1);
+        }
+    }
+
+    // Recompute `node`'s list from its own text and its children's lists
+    void rebuild(std::uint32_t node) {
+        std::vector<std::uint32_t> candidates;
+        if (nodes[node].count > 0) {
+            candidates.push_back(node);
+        }
+        for (const auto& entry : nodes[node].children) {
+            const auto& top = nodes[entry.second].top;
+            candidates.insert(candidates.end(), top.begin(), top.end());
+        }
+        const std::size_t keep = std::min(MAX_COMPLETIONS, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(keep), candidates.end(),
+                          [this](std::uint32_t a, std::uint32_t b) { return ranksBefore(a, b); });
+        candidates.resize(keep);
+        nodes[node].top = std::move(candidates);
+    }
+
+    std::vector<Node> nodes; // Node 0 is the root (the empty prefix)
+};
+
+#endif // PREFIXINDEX_H
@@ -0,0 +1,861 @@
+// QueryPlan.cpp
+#include "QueryPlan.h"
+#include "Bitmap.h"
+#include "TopK.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+
+// Relative per-row costs of the step kinds
+constexpr int COLUMN_COMPARE_COST = 1;
+constexpr int EDIT_DISTANCE_COST = 100;
+
+// Rows per block of the batch pass: small enough that a block's columns stay in cache while every
+// plan is checked against it
+constexpr std::size_t BATCH_BLOCK_ROWS = 4096;
+
+/**
+ * Keep only the positions in `selection` whose entry in `column` satisfies `keep`. This is one
+ * linear pass over a contiguous VehicleColumns array, and the selection stays in ascending order.
+ * A large selection is split into chunks that are compacted in place on the worker pool and then
+ * slid together in chunk order, which gives the same result as the sequential pass.
+ */
+template <typename Column, typename Keep>
+void narrowSelection(std::vector<std::size_t>& selection, const Column& column, Keep keep) {
+    const std::size_t chunks = scanChunkCount(selection.size());
+    if (chunks == 1) {
+        std::size_t kept = 0;
+        for (std::size_t position : selection) {
+            if (keep(column[position])) {
+                selection[kept++] = position;
+            }
+        }
+        selection.resize(kept);
+        return;
+    }
+
+    std::vector<std::size_t> begins(chunks);
+    std::vector<std::size_t> kept(chunks);
+    forEachChunk(selection.size(), chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        std::size_t out = begin;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (keep(column[selection[i]])) {
+                selection[out++] = selection[i];
+            }
+        }
+        begins[chunk] = begin;
+        kept[chunk] = out - begin;
+    });
+
+    std::size_t total = 0;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        const auto first = selection.begin() + static_cast<std::ptrdiff_t>(begins[chunk]);
+        std::move(first, first + static_cast<std::ptrdiff_t>(kept[chunk]), selection.begin() + static_cast<std::ptrdiff_t>(total));
+        total += kept[chunk];
+    }
+    selection.resize(total);
+}
+
+/**
+ * Mark the rows whose symbol in the indexed column is within `maxDistance` edits of `text`. The
+ * symbol trie yields the matching rows directly, grouped by symbol; the bitmap puts them back in
+ * order.
+ */
+Bitmap fuzzyHits(const SymbolIndex& index, std::size_t rowCount, const std::string& text, std::size_t maxDistance) {
+    Bitmap hits;
+    hits.resize(rowCount);
+    index.forEachMatch(text, maxDistance, [&](std::size_t row) { hits.set(row, true); });
+    return hits;
+}
+
+/**
+ * Fill `selection` with the rows produced by an index, in ascending order. Indexes hand rows out
+ * grouped by value; a small result is simply sorted, a large one is put in order through a bitmap.
+ */
+template <typename ForEachRow>
+void collectRows(std::size_t rowCount, std::size_t expected, ForEachRow forEachRow, std::vector<std::size_t>& selection) {
+    if (expected < rowCount / 64) {
+        selection.reserve(expected);
+        forEachRow([&](std::size_t row) { selection.push_back(row); });
+        std::sort(selection.begin(), selection.end());
+        return;
+    }
+    Bitmap hits;
+    hits.resize(rowCount);
+    forEachRow([&](std::size_t row) { hits.set(row, true); });
+    selection.reserve(expected);
+    hits.forEachSetBit([&](std::size_t row) { selection.push_back(row); });
+}
+
+/**
+ * Combine an exact value and optional min/max bounds (-1 meaning "not set") into one inclusive
+ * range. Returns false if the range is empty.
+ */
+bool compileRange(int exact, int minimum, int maximum, int& low, int& high) {
+    low = std::numeric_limits<int>::min();
+    high = std::numeric_limits<int>::max();
+    if (exact != -1) {
+        low = high = exact;
+    }
+    if (minimum != -1) {
+        low = std::max(low, minimum);
+    }
+    if (maximum != -1) {
+        high = std::min(high, maximum);
+    }
+    return low <= high;
+}
+
+/**
+ * Keep only the positions in `selection` whose symbol in `column` is within `maxDistance` edits of
+ * `text`. Each distinct value in the selection is compared once, in one batched call; the rows then
+ * only look up their value's verdict.
+ */
+void narrowSelectionByDistance(std::vector<std::size_t>& selection, const std::vector<Symbol>& column,
+                               const std::string& text, std::size_t maxDistance) {
+    std::vector<Symbol> values;
+    values.reserve(selection.size());
+    for (std::size_t position : selection) {
+        values.push_back(column[position]);
+    }
+    SymbolMatchCache cache(text, maxDistance);
+    cache.prime(values);
+    narrowSelection(selection, column, [&](Symbol symbol) { return cache.matches(symbol); });
+}
+
+} // namespace
+
+/**
+ * The constructor `VehicleQueryPlan` compiles `searchCriteria` into filter steps. The vehicle type is
+ * parsed once, passenger and storage constraints become inclusive ranges, and a make or model
+ * searched with a distance of 0 is looked up in the symbol table so it becomes an integer compare.
+ * A type that does not parse, an empty range, or an exact make or model that was never interned
+ * means nothing can match and the plan is marked empty.
+ *
+ * @param searchCriteria The `searchCriteria` parameter holds the search criteria to compile.
+ */
+VehicleQueryPlan::VehicleQueryPlan(const SearchCriteria& searchCriteria)
+    : criteria(searchCriteria), type(VehicleType::Unknown), makeSymbol(NO_SYMBOL), modelSymbol(NO_SYMBOL),
+      passengersLow(std::numeric_limits<int>::min()), passengersHigh(std::numeric_limits<int>::max()),
+      storageLow(std::numeric_limits<int>::min()), storageHigh(std::numeric_limits<int>::max()), neverMatches(false) {
+    if (!criteria.type.empty()) {
+        type = vehicleTypeFromString(criteria.type);
+        neverMatches = neverMatches || type == VehicleType::Unknown;
+        steps.push_back(Step{ StepKind::Type, COLUMN_COMPARE_COST, 0 });
+    }
+
+    // An exact capacity and min/max bounds collapse into one inclusive range per column
+    if (criteria.passengerCapacity != -1 || criteria.minPassengers != -1 || criteria.maxPassengers != -1) {
+        if (!compileRange(criteria.passengerCapacity, criteria.minPassengers, criteria.maxPassengers, passengersLow, passengersHigh)) {
+            neverMatches = true;
+        }
+        steps.push_back(Step{ StepKind::Passengers, COLUMN_COMPARE_COST, 0 });
+    }
+    if (criteria.storageCapacity != -1 || criteria.minStorage != -1 || criteria.maxStorage != -1) {
+        if (!compileRange(criteria.storageCapacity, criteria.minStorage, criteria.maxStorage, storageLow, storageHigh)) {
+            neverMatches = true;
+        }
+        steps.push_back(Step{ StepKind::Storage, COLUMN_COMPARE_COST, 0 });
+    }
+    if (criteria.filterByAvailability) {
+        steps.push_back(Step{ StepKind::Availability, COLUMN_COMPARE_COST, 0 });
+    }
+
+    // An edit distance of 0 is an exact match, which is an integer compare on the interned symbols
+    if (!criteria.make.empty()) {
+        if (criteria.maxDistanceMake == 0) {
+            makeSymbol = SymbolTable::global().find(criteria.make);
+            neverMatches = neverMatches || makeSymbol == NO_SYMBOL;
+            steps.push_back(Step{ StepKind::ExactMake, COLUMN_COMPARE_COST, 0 });
+        } else {
+            steps.push_back(Step{ StepKind::FuzzyMake, EDIT_DISTANCE_COST, 0 });
+        }
+    }
+    if (!criteria.model.empty()) {
+        if (criteria.maxDistanceModel == 0) {
+            modelSymbol = SymbolTable::global().find(criteria.model);
+            neverMatches = neverMatches || modelSymbol == NO_SYMBOL;
+            steps.push_back(Step{ StepKind::ExactModel, COLUMN_COMPARE_COST, 0 });
+        } else {
+            steps.push_back(Step{ StepKind::FuzzyModel, EDIT_DISTANCE_COST, 0 });
+        }
+    }
+}
+
+/**
+ * The function `execute` orders the plan's steps for this repository and applies them. Steps are
+ * sorted by cost and then by estimated row count; the first one seeds the selection and each
+ * following step narrows it, stopping early once nothing is left.
+ *
+ * @param repository The `repository` parameter is the vehicle repository to search.
+ *
+ * @return The positions of the matching vehicles in `repository.getAll()`, in ascending order (so
+ * results come out in repository order).
+ */
+std::vector<std::size_t> VehicleQueryPlan::execute(const Repository<Vehicle>& repository) const {
+    std::vector<std::size_t> selection;
+    if (neverMatches) {
+        return selection;
+    }
+
+    const std::vector<Step> ordered = orderSteps(repository);
+    if (ordered.empty()) {
+        selection.resize(repository.getAll().size());
+        std::iota(selection.begin(), selection.end(), std::size_t{ 0 });
+        return selection;
+    }
+
+    seed(ordered.front(), repository, selection);
+    for (std::size_t i = 1; i < ordered.size() && !selection.empty(); ++i) {
+        narrow(ordered[i], repository, selection);
+    }
+    return selection;
+}
+
+/**
+ * The function `cursor` runs the plan lazily. If the cheapest step can be answered from an index,
+ * its rows are collected up front as the candidates; otherwise every row is a candidate. All the
+ * remaining steps become a per-row predicate that the cursor evaluates only as results are pulled,
+ * in the same cheap-first order `execute` uses. Fuzzy make/model verdicts are cached per distinct
+ * value, so each one is computed at most once however many rows are read.
+ *
+ * @param repository The `repository` parameter is the vehicle repository to search.
+ *
+ * @return A cursor yielding the matching vehicles in repository order.
+ */
+SearchCursor<Vehicle> VehicleQueryPlan::cursor(const Repository<Vehicle>& repository) const {
+    const auto& vehicles = repository.getAll();
+    if (neverMatches) {
+        return SearchCursor<Vehicle>(vehicles, std::vector<std::size_t>{}, nullptr);
+    }
+
+    std::vector<Step> remaining = orderSteps(repository);
+    std::vector<std::size_t> candidates;
+    const bool seeded = !remaining.empty() && seedsFromIndex(remaining.front());
+    if (seeded) {
+        seed(remaining.front(), repository, candidates);
+        remaining.erase(remaining.begin());
+    }
+    if (remaining.empty()) {
+        return seeded ? SearchCursor<Vehicle>(vehicles, std::move(candidates), nullptr)
+                      : SearchCursor<Vehicle>(vehicles, nullptr);
+    }
+
+    // The predicate outlives this call, so it holds its own copy of the plan and its caches
+    auto makeMatches = std::make_shared<SymbolMatchCache>(criteria.make, criteria.maxDistanceMake);
+    auto modelMatches = std::make_shared<SymbolMatchCache>(criteria.model, criteria.maxDistanceModel);
+    const VehicleColumns* columns = &repository.getColumns();
+    SearchCursor<Vehicle>::Predicate keep = [plan = *this, remaining, columns, makeMatches, modelMatches](std::size_t row, const Vehicle&) {
+        for (const Step& step : remaining) {
+            if (!plan.rowPasses(step, *columns, row, *makeMatches, *modelMatches)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    return seeded ? SearchCursor<Vehicle>(vehicles, std::move(candidates), std::move(keep))
+                  : SearchCursor<Vehicle>(vehicles, std::move(keep));
+}
+
+/**
+ * The function `executeBatch` evaluates many plans together. Plans with the same cache key are
+ * evaluated once and share the result, and a plan whose first step seeds from an index keeping
+ * fewer than 1/64 of the rows is cheaper to run on its own through `execute`. The steps of all the
+ * other plans are pooled into distinct filters (a step that several plans have, such as "type Car"
+ * or the same fuzzy make, is one filter), and the repository is read once, a block of rows at a
+ * time: each filter marks the block's rows it keeps in a bit mask, then each plan ANDs the masks of
+ * its filters a word at a time and collects the surviving rows. The work per row therefore grows
+ * with the number of distinct filters, not with the number of plans. Fuzzy filters share one
+ * distance cache per query text, built for the largest threshold used with that text, so each
+ * distinct make or model is compared with each distinct text at most once across the batch.
+ *
+ * @param plans The `plans` parameter is the list of plans to run.
+ * @param repository The `repository` parameter is the vehicle repository to search.
+ *
+ * @return One list per plan of the positions in `repository.getAll()` that it matches, in ascending
+ * order, equal to what `execute` returns for that plan.
+ */
+std::vector<std::vector<std::size_t>> VehicleQueryPlan::executeBatch(const std::vector<VehicleQueryPlan>& plans,
+                                                                     const Repository<Vehicle>& repository) {
+    struct Filter {
+        std::size_t plan;               // A plan that has the step
+        Step step;                      // The step
+        std::size_t makeCache = 0;      // Index of the distances for a fuzzy make in `caches`
+        std::size_t modelCache = 0;     // Index of the distances for a fuzzy model in `caches`
+    };
+
+    const std::size_t rowCount = repository.getAll().size();
+    std::vector<std::vector<std::size_t>> results(plans.size());
+    std::vector<std::size_t> sameAs(plans.size());
+    std::unordered_map<std::string, std::size_t> firstWithKey;
+    std::vector<Filter> filters;
+    std::unordered_map<std::string, std::size_t> filterOf;              // Step key -> index in `filters`
+    std::vector<std::pair<std::size_t, std::vector<std::size_t>>> scans; // (plan, its filters)
+    std::unordered_map<std::string, std::size_t> thresholds;            // Fuzzy text -> largest threshold
+    for (std::size_t i = 0; i < plans.size(); ++i) {
+        const VehicleQueryPlan& plan = plans[i];
+        sameAs[i] = firstWithKey.emplace(plan.cacheKey(), i).first->second;
+        if (sameAs[i] != i || plan.neverMatches) {
+            continue;
+        }
+        const std::vector<Step> ordered = plan.orderSteps(repository);
+        if (!ordered.empty() && plan.seedsFromIndex(ordered.front()) && ordered.front().estimate < rowCount / 64) {
+            results[i] = plan.execute(repository);
+            continue;
+        }
+        std::vector<std::size_t> uses;
+        for (const Step& step : ordered) {
+            const auto added = filterOf.emplace(plan.stepKey(step), filters.size());
+            if (added.second) {
+                filters.push_back(Filter{ i, step });
+            }
+            uses.push_back(added.first->second);
+            if (step.kind == StepKind::FuzzyMake || step.kind == StepKind::FuzzyModel) {
+                const bool make = step.kind == StepKind::FuzzyMake;
+                std::size_t& threshold = thresholds[make ? plan.criteria.make : plan.criteria.model];
+                threshold = std::max(threshold, make ? plan.criteria.maxDistanceMake : plan.criteria.maxDistanceModel);
+            }
+        }
+        scans.emplace_back(i, std::move(uses));
+    }
+
+    // Makes and models are interned in the same table, so one cache per text serves both columns.
+    // Entry 0 stands in for filters that are not fuzzy.
+    std::vector<SymbolMatchCache> caches = { SymbolMatchCache("", 0) };
+    std::unordered_map<std::string, std::size_t> cacheOf;
+    for (const auto& entry : thresholds) {
+        cacheOf.emplace(entry.first, caches.size());
+        caches.emplace_back(entry.first, entry.second);
+    }
+    for (Filter& filter : filters) {
+        if (filter.step.kind == StepKind::FuzzyMake) {
+            filter.makeCache = cacheOf[plans[filter.plan].criteria.make];
+        } else if (filter.step.kind == StepKind::FuzzyModel) {
+            filter.modelCache = cacheOf[plans[filter.plan].criteria.model];
+        }
+    }
+
+    constexpr std::size_t BLOCK_WORDS = BATCH_BLOCK_ROWS / 64;
+    const VehicleColumns& columns = repository.getColumns();
+    std::vector<std::uint64_t> masks(filters.size() * BLOCK_WORDS);
+    for (std::size_t begin = 0; begin < rowCount && !scans.empty(); begin += BATCH_BLOCK_ROWS) {
+        const std::size_t end = std::min(rowCount, begin + BATCH_BLOCK_ROWS);
+        const std::size_t words = (end - begin + 63) / 64;
+
+        std::fill(masks.begin(), masks.end(), 0);
+        for (std::size_t f = 0; f < filters.size(); ++f) {
+            const Filter& filter = filters[f];
+            const VehicleQueryPlan& plan = plans[filter.plan];
+            std::uint64_t* mask = masks.data() + f * BLOCK_WORDS;
+            for (std::size_t row = begin; row < end; ++row) {
+                if (plan.rowPasses(filter.step, columns, row, caches[filter.makeCache], caches[filter.modelCache])) {
+                    mask[(row - begin) / 64] |= std::uint64_t{ 1 } << ((row - begin) % 64);
+                }
+            }
+        }
+
+        for (const auto& scan : scans) {
+            std::vector<std::size_t>& positions = results[scan.first];
+            for (std::size_t w = 0; w < words; ++w) {
+                const std::size_t bits = std::min<std::size_t>(64, end - begin - w * 64);
+                std::uint64_t word = bits == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << bits) - 1;
+                for (std::size_t f : scan.second) {
+                    word &= masks[f * BLOCK_WORDS + w];
+                }
+                while (word != 0) {
+                    positions.push_back(begin + w * 64 + static_cast<std::size_t>(__builtin_ctzll(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < plans.size(); ++i) {
+        if (sameAs[i] != i) {
+            results[i] = results[sameAs[i]];
+        }
+    }
+    return results;
+}
+
+/**
+ * The function `matchesRow` checks one row against every step of the plan, in compiled order. It is
+ * what a standing query uses to decide whether a vehicle that was just added, removed, rented or
+ * returned is in its result, without running the plan over the repository.
+ *
+ * @param columns The `columns` parameter is the repository's attribute columns.
+ * @param row The `row` parameter is the vehicle's position.
+ * @param makeMatches The `makeMatches` parameter caches distances from the fuzzy make.
+ * @param modelMatches The `modelMatches` parameter caches distances from the fuzzy model.
+ *
+ * @return True if the row passes every step.
+ */
+bool VehicleQueryPlan::matchesRow(const VehicleColumns& columns, std::size_t row,
+                                  SymbolMatchCache& makeMatches, SymbolMatchCache& modelMatches) const {
+    if (neverMatches) {
+        return false;
+    }
+    for (const Step& step : steps) {
+        if (!rowPasses(step, columns, row, makeMatches, modelMatches)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * The function `executeWithin` applies every step of the plan to a given selection instead of
+ * seeding one from the repository. It is how a cached result for broader criteria is refined.
+ *
+ * @param repository The `repository` parameter is the vehicle repository to search.
+ * @param selection The `selection` parameter is the ascending list of positions to start from.
+ *
+ * @return The positions of `selection` that match, in ascending order.
+ */
+std::vector<std::size_t> VehicleQueryPlan::executeWithin(const Repository<Vehicle>& repository, std::vector<std::size_t> selection) const {
+    if (neverMatches) {
+        return {};
+    }
+    const std::vector<Step> ordered = orderSteps(repository);
+    for (std::size_t i = 0; i < ordered.size() && !selection.empty(); ++i) {
+        narrow(ordered[i], repository, selection);
+    }
+    return selection;
+}
+
+/**
+ * The function `estimateMatches` bounds the size of the result by the most selective step's
+ * estimate, since every match has to pass every step.
+ *
+ * @param repository The `repository` parameter is the vehicle repository to search.
+ *
+ * @return An upper bound on the number of matching vehicles (0 if the plan never matches).
+ */
+std::size_t VehicleQueryPlan::estimateMatches(const Repository<Vehicle>& repository) const {
+    if (neverMatches) {
+        return 0;
+    }
+    std::size_t bound = repository.getAll().size();
+    for (const auto& step : steps) {
+        bound = std::min(bound, estimateRows(step, repository));
+    }
+    return bound;
+}
+
+/**
+ * The function `cacheKey` writes out the compiled form of the plan: the resolved type, the
+ * inclusive capacity ranges, the availability filter and each make/model with its distance. Fields
+ * that do not constrain anything are written as "*", and every plan that can never match has the
+ * same key.
+ *
+ * @return The normalised key.
+ */
+std::string VehicleQueryPlan::cacheKey() const {
+    if (neverMatches) {
+        return "none";
+    }
+    auto text = [](const std::string& value, std::size_t maxDistance) {
+        // Length-prefixed, so no make or model can run into the next field
+        return value.empty() ? std::string("*") : std::to_string(maxDistance) + ":" + std::to_string(value.size()) + ":" + value;
+    };
+    return (criteria.type.empty() ? std::string("*") : std::to_string(static_cast<int>(type)))
+        + "|" + std::to_string(passengersLow) + ".." + std::to_string(passengersHigh)
+        + "|" + std::to_string(storageLow) + ".." + std::to_string(storageHigh)
+        + "|" + (criteria.filterByAvailability ? (criteria.availability ? "1" : "0") : "*")
+        + "|" + text(criteria.make, criteria.maxDistanceMake)
+        + "|" + text(criteria.model, criteria.maxDistanceModel);
+}
+
+/**
+ * The function `stepKey` describes one step of the plan with the parameters it depends on, so that
+ * equal keys from different plans keep exactly the same rows.
+ *
+ * @param step The `step` parameter is one of the plan's steps.
+ *
+ * @return The normalised form of the step.
+ */
+std::string VehicleQueryPlan::stepKey(const Step& step) const {
+    switch (step.kind) {
+    case StepKind::Type:
+        return "T" + std::to_string(static_cast<int>(type));
+    case StepKind::Passengers:
+        return "P" + std::to_string(passengersLow) + ".." + std::to_string(passengersHigh);
+    case StepKind::Storage:
+        return "S" + std::to_string(storageLow) + ".." + std::to_string(storageHigh);
+    case StepKind::Availability:
+        return criteria.availability ? "A1" : "A0";
+    case StepKind::ExactMake:
+        return "M" + std::to_string(makeSymbol);
+    case StepKind::ExactModel:
+        return "m" + std::to_string(modelSymbol);
+    case StepKind::FuzzyMake:
+        return "F" + std::to_string(criteria.maxDistanceMake) + ":" + criteria.make;
+    case StepKind::FuzzyModel:
+        return "f" + std::to_string(criteria.maxDistanceModel) + ":" + criteria.model;
+    }
+    return "";
+}
+
+/**
+ * The function `refines` checks, field by field, that this plan is at least as strict as
+ * `broader`: the same type or none required by `broader`, capacity ranges inside `broader`'s, the
+ * same availability filter if `broader` has one, and the same make and model text with no larger
+ * a distance. A plan that can never match refines everything.
+ *
+ * @param broader The `broader` parameter is the plan to compare against.
+ *
+ * @return True if this plan's matches are always a subset of `broader`'s.
+ */
+bool VehicleQueryPlan::refines(const VehicleQueryPlan& broader) const {
+    if (neverMatches) {
+        return true;
+    }
+    if (broader.neverMatches) {
+        return false;
+    }
+    auto textRefines = [](const std::string& value, std::size_t maxDistance, const std::string& broaderValue, std::size_t broaderDistance) {
+        return broaderValue.empty() || (value == broaderValue && maxDistance <= broaderDistance);
+    };
+    return (broader.criteria.type.empty() || (!criteria.type.empty() && type == broader.type))
+        && passengersLow >= broader.passengersLow && passengersHigh <= broader.passengersHigh
+        && storageLow >= broader.storageLow && storageHigh <= broader.storageHigh
+        && (!broader.criteria.filterByAvailability
+            || (criteria.filterByAvailability && criteria.availability == broader.criteria.availability))
+        && textRefines(criteria.make, criteria.maxDistanceMake, broader.criteria.make, broader.criteria.maxDistanceMake)
+        && textRefines(criteria.model, criteria.maxDistanceModel, broader.criteria.model, broader.criteria.maxDistanceModel);
+}
+
+/**
+ * The function `executeRanked` ranks the matches without building the full match list when the
+ * plan has a fuzzy make or model. The fuzzy index reports the distinct values within the threshold
+ * together with their distances, and the rows holding them are taken one distance at a time,
+ * closest first. Each group is narrowed through the other steps and its survivors are bucketed by
+ * their whole edit distance (plus the other fuzzy column's distance, if there is one). Once every
+ * group at or below a distance has been read, the bucket for that distance is complete and is
+ * pushed into a bounded heap in row order. The attribute fit only adds a fraction below one, so as
+ * soon as the heap's worst score beats the next distance, no remaining row can enter it and the
+ * walk stops. Without a fuzzy step every match scores below one, so all of them are ranked.
+ *
+ * @param repository The `repository` parameter is the vehicle repository to search.
+ * @param limit The `limit` parameter is the number of matches to keep.
+ *
+ * @return Up to `limit` (score, position) pairs, lowest score first.
+ */
+std::vector<std::pair<double, std::size_t>> VehicleQueryPlan::executeRanked(const Repository<Vehicle>& repository, std::size_t limit) const {
+    if (neverMatches) {
+        return {};
+    }
+    const VehicleColumns& columns = repository.getColumns();
+    auto fraction = [&](std::size_t position) { return attributeFit(columns, position); };
+
+    auto hasStep = [&](StepKind kind) {
+        return std::any_of(steps.begin(), steps.end(), [kind](const Step& step) { return step.kind == kind; });
+    };
+    const bool fuzzyMake = hasStep(StepKind::FuzzyMake);
+    const bool fuzzyModel = hasStep(StepKind::FuzzyModel);
+    if (!fuzzyMake && !fuzzyModel) {
+        return rankBuckets({ execute(repository) }, limit, fraction);
+    }
+
+    // Rows come from the make index when the make is fuzzy; a fuzzy model then adds its distance
+    const StepKind driver = fuzzyMake ? StepKind::FuzzyMake : StepKind::FuzzyModel;
+    const SymbolIndex& index = fuzzyMake ? columns.makeIndex : columns.modelIndex;
+    std::vector<std::pair<Symbol, std::size_t>> symbols;
+    index.matchingSymbols(fuzzyMake ? criteria.make : criteria.model,
+                          fuzzyMake ? criteria.maxDistanceMake : criteria.maxDistanceModel, symbols);
+    std::sort(symbols.begin(), symbols.end(), [](const std::pair<Symbol, std::size_t>& a, const std::pair<Symbol, std::size_t>& b) {
+        return a.second < b.second;
+    });
+
+    std::vector<Step> remaining = orderSteps(repository);
+    remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [driver](const Step& step) { return step.kind == driver; }),
+                    remaining.end());
+    SymbolMatchCache makeDistances(criteria.make, criteria.maxDistanceMake);
+    SymbolMatchCache modelDistances(criteria.model, criteria.maxDistanceModel);
+    const bool addModelDistance = fuzzyMake && fuzzyModel;
+
+    TopK<std::size_t> best(limit);
+    std::vector<std::vector<std::size_t>> pending; // Whole distance -> surviving rows not ranked yet
+    auto rank = [&](std::size_t total) {
+        if (total >= pending.size()) {
+            return;
+        }
+        std::vector<std::size_t>& rows = pending[total];
+        std::sort(rows.begin(), rows.end());
+        for (std::size_t row : rows) {
+            best.push(static_cast<double>(total) + fraction(row), row);
+        }
+        std::vector<std::size_t>().swap(rows);
+    };
+
+    std::size_t distance = 0;
+    for (std::size_t next = 0; next < symbols.size(); ++distance) {
+        // Every row not ranked yet scores at least `distance`
+        if (!best.wouldAccept(static_cast<double>(distance))) {
+            return best.takeSorted();
+        }
+        for (; next < symbols.size() && symbols[next].second == distance; ++next) {
+            for (std::size_t row : index.rowsOf(symbols[next].first)) {
+                bool keep = true;
+                for (std::size_t s = 0; keep && s < remaining.size(); ++s) {
+                    keep = rowPasses(remaining[s], columns, row, makeDistances, modelDistances);
+                }
+                if (!keep) {
+                    continue;
+                }
+                const std::size_t total = distance + (addModelDistance ? modelDistances.distance(columns.model[row]) : 0);
+                if (total >= pending.size()) {
+                    pending.resize(total + 1);
+                }
+                pending[total].push_back(row);
+            }
+        }
+        // Later groups are further away, so no more rows can land in this bucket
+        rank(distance);
+    }
+    for (; distance < pending.size() && best.wouldAccept(static_cast<double>(distance)); ++distance) {
+        rank(distance);
+    }
+    return best.takeSorted();
+}
+
+/**
+ * The function `attributeFit` measures how much more capacity a vehicle has than the criteria ask
+ * for. For each of passengers and storage with a lower bound, the excess over that bound is mapped
+ * into [0, 1) (0 for an exact fit); the result is the average over both columns, so it is always
+ * below 1 and never outweighs a single edit.
+ *
+ * @param columns The `columns` parameter is the repository's attribute columns.
+ * @param row The `row` parameter is the vehicle's position.
+ *
+ * @return The fit penalty in [0, 1), lower is better.
+ */
+double VehicleQueryPlan::attributeFit(const VehicleColumns& columns, std::size_t row) const {
+    auto excess = [](int value, int low) {
+        if (low < 0 || value < low) {
+            return 0.0;
+        }
+        const double over = static_cast<double>(value - low);
+        return over / (over + static_cast<double>(low) + 1.0);
+    };
+    // Without a lower bound (the range starts at INT_MIN) a column adds nothing
+    return (excess(columns.passengers[row], passengersLow) + excess(columns.capacity[row], storageLow)) / 2.0;
+}
+
+/**
+ * The function `orderSteps` estimates each step's row count for this repository and sorts the
+ * steps by cost and then by estimate, keeping the compiled order among equal steps.
+ *
+ * @param repository The `repository` parameter is the vehicle repository being searched.
+ *
+ * @return The plan's steps in execution order, with their estimates filled in.
+ */
+std::vector<VehicleQueryPlan::Step> VehicleQueryPlan::orderSteps(const Repository<Vehicle>& repository) const {
+    std::vector<Step> ordered = steps;
+    for (auto& step : ordered) {
+        step.estimate = estimateRows(step, repository);
+    }
+    std::stable_sort(ordered.begin(), ordered.end(), [](const Step& a, const Step& b) {
+        return a.cost != b.cost ? a.cost < b.cost : a.estimate < b.estimate;
+    });
+    return ordered;
+}
+
+/**
+ * The function `estimateRows` predicts how many vehicles a step keeps, using the repository's
+ * counters and indexes where they give an exact answer and assuming the worst (every row) where
+ * there is no statistic.
+ *
+ * @param step The `step` parameter is the step to estimate.
+ * @param repository The `repository` parameter is the vehicle repository being searched.
+ *
+ * @return The expected number of rows passing the step.
+ */
+std::size_t VehicleQueryPlan::estimateRows(const Step& step, const Repository<Vehicle>& repository) const {
+    const VehicleColumns& columns = repository.getColumns();
+    switch (step.kind) {
+    case StepKind::Type:
+        return repository.countAvailable(type) + repository.countRented(type);
+    case StepKind::Availability: {
+        const auto& counters = criteria.availability ? columns.availableByType : columns.rentedByType;
+        return std::accumulate(counters.begin(), counters.end(), std::size_t{ 0 });
+    }
+    case StepKind::Passengers:
+        return columns.passengersIndex.countInRange(passengersLow, passengersHigh);
+    case StepKind::Storage:
+        return columns.capacityIndex.countInRange(storageLow, storageHigh);
+    case StepKind::ExactMake:
+        return columns.makeIndex.rowsOf(makeSymbol).size();
+    case StepKind::ExactModel:
+        return columns.modelIndex.rowsOf(modelSymbol).size();
+    default:
+        return repository.getAll().size();
+    }
+}
+
+/**
+ * The function `seed` produces the initial selection from the first step. Exact make/model steps
+ * start from their posting list, passenger and storage ranges from their sorted index, an
+ * "available" filter from the availability bitmap and a fuzzy step from the symbol trie; any other
+ * step starts from every row and narrows.
+ *
+ * @param step The `step` parameter is the first step of the plan.
+ * @param repository The `repository` parameter is the vehicle repository being searched.
+ * @param selection The `selection` parameter receives the matching positions in ascending order.
+ */
+void VehicleQueryPlan::seed(const Step& step, const Repository<Vehicle>& repository, std::vector<std::size_t>& selection) const {
+    const VehicleColumns& columns = repository.getColumns();
+    const std::size_t rowCount = repository.getAll().size();
+    switch (step.kind) {
+    case StepKind::Passengers:
+    case StepKind::Storage: {
+        const bool passengers = step.kind == StepKind::Passengers;
+        const RangeIndex& index = passengers ? columns.passengersIndex : columns.capacityIndex;
+        const int low = passengers ? passengersLow : storageLow;
+        const int high = passengers ? passengersHigh : storageHigh;
+        collectRows(rowCount, step.estimate, [&](auto visit) { index.forEachInRange(low, high, visit); }, selection);
+        return;
+    }
+    case StepKind::ExactMake:
+    case StepKind::ExactModel: {
+        const SymbolIndex& index = step.kind == StepKind::ExactMake ? columns.makeIndex : columns.modelIndex;
+        const auto& rows = index.rowsOf(step.kind == StepKind::ExactMake ? makeSymbol : modelSymbol);
+        collectRows(rowCount, rows.size(), [&](auto visit) {
+            for (std::size_t row : rows) {
+                visit(row);
+            }
+        }, selection);
+        return;
+    }
+    case StepKind::Availability:
+        if (criteria.availability) {
+            selection.reserve(step.estimate);
+            columns.forEachAvailable([&](std::size_t row) { selection.push_back(row); });
+            return;
+        }
+        break;
+    case StepKind::FuzzyMake:
+    case StepKind::FuzzyModel: {
+        const bool make = step.kind == StepKind::FuzzyMake;
+        const Bitmap hits = fuzzyHits(make ? columns.makeIndex : columns.modelIndex, rowCount,
+                                      make ? criteria.make : criteria.model,
+                                      make ? criteria.maxDistanceMake : criteria.maxDistanceModel);
+        hits.forEachSetBit([&](std::size_t row) { selection.push_back(row); });
+        return;
+    }
+    default:
+        break;
+    }
+
+    selection.resize(rowCount);
+    std::iota(selection.begin(), selection.end(), std::size_t{ 0 });
+    narrow(step, repository, selection);
+}
+
+/**
+ * The function `seedsFromIndex` reports whether `seed` can produce a step's rows from an index
+ * rather than by scanning every row.
+ *
+ * @param step The `step` parameter is the step to check.
+ *
+ * @return True for exact make/model, passenger/storage range, fuzzy and "available" steps.
+ */
+bool VehicleQueryPlan::seedsFromIndex(const Step& step) const {
+    switch (step.kind) {
+    case StepKind::Type:
+        return false;
+    case StepKind::Availability:
+        return criteria.availability;
+    default:
+        return true;
+    }
+}
+
+/**
+ * The function `rowPasses` applies one step to a single row, for the lazy cursor, the batch pass
+ * and standing queries. It is the row-at-a-time form of `narrow`; fuzzy steps look the row's make or model up in a
+ * cache of per-symbol distances, which may have been built for a larger threshold than this plan's
+ * (its distances are exact up to that threshold, so the comparison is still exact).
+ *
+ * @param step The `step` parameter is the step to apply.
+ * @param columns The `columns` parameter is the repository's attribute columns.
+ * @param row The `row` parameter is the vehicle's position.
+ * @param makeMatches The `makeMatches` parameter caches distances from the fuzzy make.
+ * @param modelMatches The `modelMatches` parameter caches distances from the fuzzy model.
+ *
+ * @return True if the row passes the step.
+ */
+bool VehicleQueryPlan::rowPasses(const Step& step, const VehicleColumns& columns, std::size_t row,
+                                 SymbolMatchCache& makeMatches, SymbolMatchCache& modelMatches) const {
+    switch (step.kind) {
+    case StepKind::Type:
+        return columns.type[row] == type;
+    case StepKind::Passengers:
+        return columns.passengers[row] >= passengersLow && columns.passengers[row] <= passengersHigh;
+    case StepKind::Storage:
+        return columns.capacity[row] >= storageLow && columns.capacity[row] <= storageHigh;
+    case StepKind::Availability:
+        return columns.available[row] == criteria.availability;
+    case StepKind::ExactMake:
+        return columns.make[row] == makeSymbol;
+    case StepKind::ExactModel:
+        return columns.model[row] == modelSymbol;
+    case StepKind::FuzzyMake:
+        return makeMatches.distance(columns.make[row]) <= criteria.maxDistanceMake;
+    case StepKind::FuzzyModel:
+        return modelMatches.distance(columns.model[row]) <= criteria.maxDistanceModel;
+    }
+    return false;
+}
+
+/**
+ * The function `narrow` applies one step to an existing selection. Column steps are a linear pass
+ * over one VehicleColumns array; a fuzzy step uses the symbol trie while more rows remain than there
+ * are distinct values, and otherwise compares each distinct value in the selection once.
+ *
+ * @param step The `step` parameter is the step to apply.
+ * @param repository The `repository` parameter is the vehicle repository being searched.
+ * @param selection The `selection` parameter is the ascending list of positions to narrow in place.
+ */
+void VehicleQueryPlan::narrow(const Step& step, const Repository<Vehicle>& repository, std::vector<std::size_t>& selection) const {
+    const VehicleColumns& columns = repository.getColumns();
+    switch (step.kind) {
+    case StepKind::Type:
+        narrowSelection(selection, columns.type, [&](VehicleType vehicleType) { return vehicleType == type; });
+        break;
+    case StepKind::Passengers:
+        narrowSelection(selection, columns.passengers, [&](int passengers) { return passengers >= passengersLow && passengers <= passengersHigh; });
+        break;
+    case StepKind::Storage:
+        narrowSelection(selection, columns.capacity, [&](int capacity) { return capacity >= storageLow && capacity <= storageHigh; });
+        break;
+    case StepKind::Availability:
+        narrowSelection(selection, columns.available, [&](bool available) { return available == criteria.availability; });
+        break;
+    case StepKind::ExactMake:
+        narrowSelection(selection, columns.make, [&](Symbol symbol) { return symbol == makeSymbol; });
+        break;
+    case StepKind::ExactModel:
+        narrowSelection(selection, columns.model, [&](Symbol symbol) { return symbol == modelSymbol; });
+        break;
+    case StepKind::FuzzyMake:
+    case StepKind::FuzzyModel: {
+        const bool make = step.kind == StepKind::FuzzyMake;
+        const SymbolIndex& index = make ? columns.makeIndex : columns.modelIndex;
+        const std::string& text = make ? criteria.make : criteria.model;
+        const std::size_t maxDistance = make ? criteria.maxDistanceMake : criteria.maxDistanceModel;
+        if (selection.size() > index.distinctCount()) {
+            const Bitmap hits = fuzzyHits(index, repository.getAll().size(), text, maxDistance);
+            narrowSelection(selection, hits, [](bool hit) { return hit; });
+        } else {
+            narrowSelectionByDistance(selection, make ? columns.make : columns.model, text, maxDistance);
+        }
+        break;
+    }
+    }
+}
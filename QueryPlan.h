@@ -0,0 +1,176 @@
+// QueryPlan.h
+#ifndef QUERYPLAN_H
+#define QUERYPLAN_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "EditDistance.h"
+#include "Repository.h"
+#include "SearchCriteria.h"
+#include "SearchCursor.h"
+#include "SymbolTable.h"
+#include "Vehicle.h"
+
+// The `VehicleQueryPlan` class is a SearchCriteria compiled into an ordered list of filter steps
+// over a Repository<Vehicle>. Compilation resolves everything that does not depend on the data
+// (the vehicle type, the symbols of exact makes and models) once; execution then estimates how
+// many rows each step keeps from the repository's counters and indexes, and runs the steps
+// cheapest first and, among equally cheap steps, most selective first. The first step seeds the
+// selection from an index where one exists (make/model postings, the passenger and storage range
+// indexes, the availability bitmap) instead of listing every row, and every later step only looks
+// at rows that survived the earlier ones, so the edit-distance steps always run last and on as few
+// rows as possible.
+//
+// cursor() runs the same plan lazily: only the first step is applied up front (and only when it
+// has an index to seed from), and the rest are checked row by row as the caller pulls results.
+// executeBatch() runs many plans in a single pass over the repository, for bulk matching jobs;
+// steps that several plans have in common are checked once per row for all of them.
+//
+// RentalCompany::searchVehicles and the interactive search menu both execute this plan, so they
+// always agree on what a criteria object means.
+class VehicleQueryPlan {
+public:
+    /**
+     * @brief Compile a plan from search criteria
+     *
+     * @param searchCriteria The search criteria
+     */
+    explicit VehicleQueryPlan(const SearchCriteria& searchCriteria);
+
+    /**
+     * @brief Run the plan against a repository
+     *
+     * @param repository The repository to search
+     * @return std::vector<std::size_t> The positions in repository.getAll() of the matching vehicles, in ascending order
+     */
+    std::vector<std::size_t> execute(const Repository<Vehicle>& repository) const;
+
+    /**
+     * @brief Run the plan and keep only the best `limit` matches
+     *
+     * Matches are scored by their make and model edit distances plus an attribute-fit fraction in
+     * [0, 1) that grows the more a vehicle exceeds the requested minimum passenger and storage
+     * capacities. Lower is better; ties go to the earlier vehicle.
+     *
+     * @param repository The repository to search
+     * @param limit The number of matches to keep
+     * @return std::vector<std::pair<double, std::size_t>> (score, position in repository.getAll()) pairs, best first
+     */
+    std::vector<std::pair<double, std::size_t>> executeRanked(const Repository<Vehicle>& repository, std::size_t limit) const;
+
+    /**
+     * @brief Run the plan lazily
+     *
+     * The cursor yields the same vehicles as execute(), in the same order, but evaluates the
+     * filters only as results are requested. It must not be used after the repository changes.
+     *
+     * @param repository The repository to search
+     * @return SearchCursor<Vehicle> A cursor over the matching vehicles
+     */
+    SearchCursor<Vehicle> cursor(const Repository<Vehicle>& repository) const;
+
+    /**
+     * @brief Run the plan on a subset of the repository
+     *
+     * @param repository The repository to search
+     * @param selection Ascending positions in repository.getAll() to consider
+     * @return std::vector<std::size_t> The positions in `selection` that match, in ascending order
+     */
+    std::vector<std::size_t> executeWithin(const Repository<Vehicle>& repository, std::vector<std::size_t> selection) const;
+
+    /**
+     * @brief Run many plans against a repository together
+     *
+     * Identical plans are evaluated once, plans that an index narrows to a small fraction of the
+     * rows run on their own, and the rest share one blocked pass over the columns in which each
+     * distinct filter is checked once per row and each plan combines its filters' bit masks.
+     *
+     * @param plans The plans to run
+     * @param repository The repository to search
+     * @return std::vector<std::vector<std::size_t>> One result per plan, each equal to plans[i].execute(repository)
+     */
+    static std::vector<std::vector<std::size_t>> executeBatch(const std::vector<VehicleQueryPlan>& plans,
+                                                              const Repository<Vehicle>& repository);
+
+    /**
+     * @brief Check whether a single row matches the plan
+     *
+     * The caches must have been built for this plan's make and model queries and thresholds; they
+     * can be kept across calls (and repository changes) to avoid recomputing distances.
+     *
+     * @param columns The repository's attribute columns
+     * @param row The row to check
+     * @param makeMatches Distance cache for the fuzzy make
+     * @param modelMatches Distance cache for the fuzzy model
+     * @return bool True if the row passes every step
+     */
+    bool matchesRow(const VehicleColumns& columns, std::size_t row, SymbolMatchCache& makeMatches, SymbolMatchCache& modelMatches) const;
+
+    /**
+     * @brief Get an upper bound on the number of matches from the repository's counters and indexes
+     *
+     * @param repository The repository to search
+     * @return std::size_t The smallest row estimate of any step (the repository size if there are none)
+     */
+    std::size_t estimateMatches(const Repository<Vehicle>& repository) const;
+
+    /**
+     * @brief Get a key that is equal for plans that match exactly the same vehicles by construction
+     *
+     * Criteria that compile to the same plan (an exact capacity and the equivalent min/max range,
+     * a distance given for an empty make, an availability value without the availability filter)
+     * share a key.
+     *
+     * @return std::string The normalised form of the plan
+     */
+    std::string cacheKey() const;
+
+    /**
+     * @brief Check whether every vehicle this plan matches is also matched by another plan
+     *
+     * @param broader The other plan
+     * @return bool True if this plan's matches are a subset of `broader`'s on any repository
+     */
+    bool refines(const VehicleQueryPlan& broader) const;
+
+    /**
+     * @brief Check whether the plan can never match (e.g. an unknown type or an exact make no vehicle has)
+     *
+     * @return bool True if execute() always returns no rows
+     */
+    bool isEmpty() const { return neverMatches; }
+
+private:
+    enum class StepKind { Type, Passengers, Storage, Availability, ExactMake, ExactModel, FuzzyMake, FuzzyModel };
+
+    struct Step {
+        StepKind kind;
+        int cost;               // Relative cost per row: column compares are cheap, edit distances are not
+        std::size_t estimate;   // Rows expected to pass (filled in at execution time)
+    };
+
+    std::vector<Step> orderSteps(const Repository<Vehicle>& repository) const;
+    std::string stepKey(const Step& step) const;
+    std::size_t estimateRows(const Step& step, const Repository<Vehicle>& repository) const;
+    bool seedsFromIndex(const Step& step) const;
+    void seed(const Step& step, const Repository<Vehicle>& repository, std::vector<std::size_t>& selection) const;
+    void narrow(const Step& step, const Repository<Vehicle>& repository, std::vector<std::size_t>& selection) const;
+    bool rowPasses(const Step& step, const VehicleColumns& columns, std::size_t row,
+                   SymbolMatchCache& makeMatches, SymbolMatchCache& modelMatches) const;
+    double attributeFit(const VehicleColumns& columns, std::size_t row) const;
+
+    SearchCriteria criteria;        // The criteria the plan was compiled from
+    VehicleType type;               // Resolved criteria.type
+    Symbol makeSymbol;              // Symbol of an exact make
+    Symbol modelSymbol;             // Symbol of an exact model
+    int passengersLow;              // Inclusive passenger capacity range
+    int passengersHigh;
+    int storageLow;                 // Inclusive storage capacity range
+    int storageHigh;
+    std::vector<Step> steps;        // Filters to apply
+    bool neverMatches;              // True if no vehicle can match
+};
+
+#endif // QUERYPLAN_H
@@ -0,0 +1,127 @@
+// RangeIndex.h
+#ifndef RANGEINDEX_H
+#define RANGEINDEX_H
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+// The `RangeIndex` class is a sorted secondary index over one integer column of VehicleColumns.
+// Distinct values are kept in order in a std::map, each with a posting list of the rows holding it,
+// so "every row with a value between lo and hi" is a binary search for lo followed by a walk over
+// the values up to hi, touching only matching rows. As in SymbolIndex, each row remembers its slot
+// in its posting list, so insertion, removal and the repository's row moves are O(log distinct
+// values) or better.
+class RangeIndex {
+public:
+    /**
+     * @brief Record that row `row` holds `value`
+     *
+     * @param value The row's value
+     * @param row The row (must be the next row, i.e. rows are appended in order)
+     */
+    void insert(int value, std::size_t row) {
+        auto& rows = postings[value];
+        if (row >= slot.size()) {
+            slot.resize(row + 1);
+        }
+        slot[row] = rows.size();
+        rows.push_back(row);
+    }
+
+    /**
+     * @brief Forget that row `row` holds `value`
+     *
+     * @param value The row's value
+     * @param row The row being removed
+     */
+    void erase(int value, std::size_t row) {
+        auto it = postings.find(value);
+        auto& rows = it->second;
+        const std::size_t moved = rows.back();
+        rows[slot[row]] = moved;
+        slot[moved] = slot[row];
+        rows.pop_back();
+        if (rows.empty()) {
+            postings.erase(it);
+        }
+    }
+
+    /**
+     * @brief Record that the row holding `value` moved from `from` to `to`
+     *
+     * @param value The row's value
+     * @param from The old row
+     * @param to The new row
+     */
+    void move(int value, std::size_t from, std::size_t to) {
+        postings.find(value)->second[slot[from]] = to;
+        slot[to] = slot[from];
+    }
+
+    /**
+     * @brief Drop the bookkeeping for rows from `rows` onwards
+     *
+     * @param rows The new number of rows
+     */
+    void truncate(std::size_t rows) {
+        slot.resize(rows);
+    }
+
+    /**
+     * @brief Reserve room for `rows` rows
+     *
+     * @param rows The expected number of rows
+     */
+    void reserve(std::size_t rows) {
+        slot.reserve(rows);
+    }
+
+    /**
+     * @brief Remove all rows
+     */
+    void clear() {
+        postings.clear();
+        slot.clear();
+    }
+
+    /**
+     * @brief Count the rows with a value in [low, high]
+     *
+     * @param low The smallest value to include
+     * @param high The largest value to include
+     * @return std::size_t The number of rows in the range
+     */
+    std::size_t countInRange(int low, int high) const {
+        std::size_t count = 0;
+        for (auto it = postings.lower_bound(low); it != postings.end() && it->first <= high; ++it) {
+            count += it->second.size();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Call `visit(row)` for every row with a value in [low, high]
+     *
+     * Rows are visited in value order, not in row order.
+     *
+     * @tparam Visitor Callable taking a std::size_t row
+     * @param low The smallest value to include
+     * @param high The largest value to include
+     * @param visit The visitor
+     */
+    template <typename Visitor>
+    void forEachInRange(int low, int high, Visitor visit) const {
+        for (auto it = postings.lower_bound(low); it != postings.end() && it->first <= high; ++it) {
+            for (std::size_t row : it->second) {
+                visit(row);
+            }
+        }
+    }
+
+private:
+    std::map<int, std::vector<std::size_t>> postings;  // Value -> rows holding it, in value order
+    std::vector<std::size_t> slot;                      // Row -> index in its value's posting list
+};
+
+#endif // RANGEINDEX_H
@@ -5,13 +5,19 @@
 #include "Minibus.h"
 #include "SUV.h"
 #include "Customer.h"
+#include "ObjectPool.h"
+#include "VehicleFactory.h"
 #include "DateUtils.h"
 #include "Utils.h"
+#include "EditDistance.h"
+#include "QueryPlan.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
+#include <map>
 #include <stdexcept>
 #include <cmath>
 #include <regex>
@@ -35,6 +41,39 @@ void RentalCompany::addVehicle(const std::shared_ptr<Vehicle>& vehicle) {
         throw std::runtime_error("Vehicle with this ID already exists.");
     }
     vehicleRepository.add(vehicle);
+    fleetChanged();
+    publishChange(vehicle, {}, standingMatches(vehicle));
+}
+
+/**
+ * The addVehicles function adds a whole batch of vehicles to the repository, skipping any vehicle
+ * whose ID is already taken instead of throwing.
+ *
+ * @param vehicles The `vehicles` parameter is a vector of `std::shared_ptr<Vehicle>` to add, in order.
+ *
+ * @return The IDs of the vehicles that were not added because a vehicle with the same ID already
+ * exists in the repository or appears earlier in the batch. Callers report these together.
+ */
+std::vector<std::string> RentalCompany::addVehicles(const std::vector<std::shared_ptr<Vehicle>>& vehicles) {
+    fleetChanged();
+    const std::size_t firstAdded = vehicleRepository.getAll().size();
+    std::vector<std::string> duplicates = vehicleRepository.addAll(vehicles);
+
+    // The vehicles that were added are the rows appended after `firstAdded`
+    if (!standingQueries.empty()) {
+        const auto& all = vehicleRepository.getAll();
+        const VehicleColumns& columns = vehicleRepository.getColumns();
+        std::map<SubscriptionId, SearchDelta> deltas;
+        for (auto& entry : standingQueries) {
+            for (std::size_t row = firstAdded; row < all.size(); ++row) {
+                if (entry.second.matches(columns, row)) {
+                    deltas[entry.first].added.push_back(all[row]);
+                }
+            }
+        }
+        publishDeltas(deltas);
+    }
+    return duplicates;
 }
 
 /**
@@ -47,7 +86,10 @@ void RentalCompany::addVehicle(const std::shared_ptr<Vehicle>& vehicle) {
 void RentalCompany::removeVehicle(const std::string& vehicleID) {
     auto vehicle = vehicleRepository.findById(vehicleID);
     if (vehicle) {
+        const std::vector<SubscriptionId> before = standingMatches(vehicle);
         vehicleRepository.remove(vehicle);
+        fleetChanged();
+        publishChange(vehicle, before, {});
     } else {
         throw std::runtime_error("Vehicle with ID " + vehicleID + " not found.");
     }
@@ -93,9 +135,14 @@ void RentalCompany::removeCustomer(int customerID) {
  * availability status, rental rate, and late fee per day.
  */
 void RentalCompany::displayAvailableVehicles() const {
-    auto availableVehicles = searchItems(vehicleRepository, [](const std::shared_ptr<Vehicle>& vehicle) {
-        return vehicle->getAvailability();
-    });
+    const auto& vehicles = vehicleRepository.getAll();
+    const auto& columns = vehicleRepository.getColumns();
+
+    std::vector<std::shared_ptr<Vehicle>> availableVehicles;
+    availableVehicles.reserve(columns.available.count());
+    columns.forEachAvailable([&](std::size_t position) { availableVehicles.push_back(vehicles[position]); });
+    // Removal reorders the repository, so list by ID as displayAllVehicles does
+    sortVehiclesByID(availableVehicles);
 
     std::vector<std::string> headers = { "Type", "ID", "Make", "Model", "Passengers", "Storage Capacity", "Available", "Rental Rate £/day", "Late Fee £/day" };
     std::vector<int> widths = { 8, 10, 15, 15, 10, 16, 10, 18, 18 };
@@ -104,10 +151,12 @@ void RentalCompany::displayAvailableVehicles() const {
 
 /**
  * The function `displayAllVehicles` in the `RentalCompany` class displays information about all
- * vehicles in the repository in a tabular format.
+ * vehicles in the repository in a tabular format, ordered by vehicle ID (repository order is not
+ * meaningful once vehicles have been removed).
  */
 void RentalCompany::displayAllVehicles() const {
     auto allVehicles = vehicleRepository.getAll();
+    sortVehiclesByID(allVehicles);
 
     std::vector<std::string> headers = { "Type", "ID", "Make", "Model", "Passengers", "Storage Capacity", "Available", "Rental Rate £/day", "Late Fee £/day" };
     std::vector<int> widths = { 8, 10, 15, 15, 10, 16, 10, 18, 18 };
@@ -229,8 +278,11 @@ void RentalCompany::rentVehicle(int customerID, const std::string& vehicleID) {
     std::string rentDate = DateUtils::getCurrentDate();
     std::string dueDate = DateUtils::addDays(rentDate, rentalDays);
 
+    const std::vector<SubscriptionId> before = standingMatches(vehicle);
     customer->rentVehicle(vehicle, rentDate, dueDate);
-    vehicle->setAvailability(false);
+    vehicleRepository.setAvailability(vehicle, false);
+    fleetChanged();
+    publishChange(vehicle, before, standingMatches(vehicle));
 
     // Award loyalty points, e.g., 10 points per rental
     int earnedPoints = 10;
@@ -271,8 +323,11 @@ void RentalCompany::returnVehicle(int customerID, const std::string& vehicleID,
         throw std::runtime_error("Error: Customer ID " + std::to_string(customerID) + " has not rented Vehicle ID " + vehicleID + ".");
     }
 
+    const std::vector<SubscriptionId> before = standingMatches(vehicle);
     int daysLate = customer->returnVehicle(vehicle, returnDate);
-    vehicle->setAvailability(true);
+    vehicleRepository.setAvailability(vehicle, true);
+    fleetChanged();
+    publishChange(vehicle, before, standingMatches(vehicle));
 
     if (daysLate > 0) {
         double lateFee = daysLate * vehicle->getLateFee();
@@ -305,6 +360,13 @@ void RentalCompany::loadFromFile(const std::string& vehiclesFile, const std::str
         throw std::runtime_error("Error: Could not open vehicles file.");
     }
 
+    // List of known vehicle types
+    const std::vector<std::string> knownTypes = {"Car", "Van", "Minibus", "SUV"};
+
+    // Parse every line first and add the vehicles as one batch, so the duplicate check is a single
+    // hashed pass instead of one lookup per addVehicle call
+    std::vector<std::shared_ptr<Vehicle>> loadedVehicles;
+
     std::string line;
     while (std::getline(vFile, line)) {
         std::istringstream iss(line);
@@ -317,9 +379,6 @@ void RentalCompany::loadFromFile(const std::string& vehiclesFile, const std::str
             continue; // Skip malformed lines
         }
 
-        // List of known vehicle types
-        const std::vector<std::string> knownTypes = {"Car", "Van", "Minibus", "SUV"};
-
         std::string type;
         if (std::find(knownTypes.begin(), knownTypes.end(), typeOrId) != knownTypes.end()) {
             // The first token is a known type
@@ -344,29 +403,30 @@ void RentalCompany::loadFromFile(const std::string& vehiclesFile, const std::str
         avail = static_cast<bool>(availInt);
 
         // Create the appropriate vehicle object
-        if (type == "Car") {
-            addVehicle(std::make_shared<Car>(id, make, model, passengers, capacity, avail));
-        }
-        else if (type == "Van") {
-            addVehicle(std::make_shared<Van>(id, make, model, passengers, capacity, avail));
-        }
-        else if (type == "Minibus") {
-            addVehicle(std::make_shared<Minibus>(id, make, model, passengers, capacity, avail));
-        }
-        else if (type == "SUV") {
-            addVehicle(std::make_shared<SUV>(id, make, model, passengers, capacity, avail));
-        }
-        else {
+        VehicleType vehicleType = vehicleTypeFromString(type);
+        if (vehicleType == VehicleType::Unknown) {
             std::cerr << "Warning: Unknown vehicle type \"" << type << "\" in vehicles file: " << line << "\n";
-            addVehicle(std::make_shared<Car>(id, make, model, passengers, capacity, avail));
-            continue;
         }
+        loadedVehicles.push_back(makeVehicle(vehicleType, id, make, model, passengers, capacity, avail));
+    }
+
+    std::vector<std::string> duplicateIDs = addVehicles(loadedVehicles);
+    if (!duplicateIDs.empty()) {
+        std::cerr << "Warning: Skipped " << duplicateIDs.size() << " vehicle(s) with duplicate IDs in vehicles file:";
+        for (const auto& duplicateID : duplicateIDs) {
+            std::cerr << " " << duplicateID;
+        }
+        std::cerr << "\n";
     }
 
     if (!cFile.is_open()) {
         throw std::runtime_error("Error: Could not open customers file.");
     }
 
+    // For simplicity, assume current date as rent date and rent period as 7 days
+    const std::string rentDate = DateUtils::getCurrentDate();
+    const std::string dueDate = DateUtils::addDays(rentDate, 7);
+
     while (std::getline(cFile, line)) {
         std::istringstream iss(line);
         int customerID;
@@ -390,19 +450,19 @@ void RentalCompany::loadFromFile(const std::string& vehiclesFile, const std::str
             iss.seekg(pos); // Seek back to the stored position
         }
 
-        auto customer = std::make_shared<Customer>(customerID, name);
+        auto customer = makePooled<Customer>(customerID, name);
         customer->setLoyaltyPoints(loyaltyPoints);
 
         std::string vehicleID;
         while (iss >> vehicleID) {
             auto vehicle = searchVehicle(vehicleID);
             if (vehicle) {
-                // For simplicity, assume current date as rent date and rent period as 7 days
-                std::string rentDate = DateUtils::getCurrentDate();
-                std::string dueDate = DateUtils::addDays(rentDate, 7);
                 RentalInfo rental = { vehicle, rentDate, dueDate };
+                const std::vector<SubscriptionId> before = standingMatches(vehicle);
                 customer->addRental(rental);
-                vehicle->setAvailability(false);
+                vehicleRepository.setAvailability(vehicle, false);
+                fleetChanged();
+                publishChange(vehicle, before, standingMatches(vehicle));
             }
             else {
                 std::cerr << "Warning: Vehicle ID \"" << vehicleID << "\" not found for customer ID " << customerID << ".\n";
@@ -432,27 +492,11 @@ void RentalCompany::saveToFile(const std::string& vehiclesFile, const std::strin
         throw std::runtime_error("Error: Could not open vehicles file for writing.");
     }
 
+    // Removal reorders the repository; writing by ID keeps the file stable across saves
     auto vehicles = vehicleRepository.getAll();
+    sortVehiclesByID(vehicles);
     for (const auto& vehicle : vehicles) {
-        // Determine vehicle type
-        std::string type;
-        if (dynamic_cast<Car*>(vehicle.get())) {
-            type = "Car";
-        }
-        else if (dynamic_cast<Van*>(vehicle.get())) {
-            type = "Van";
-        }
-        else if (dynamic_cast<Minibus*>(vehicle.get())) {
-            type = "Minibus";
-        }
-        else if (dynamic_cast<SUV*>(vehicle.get())) {
-            type = "SUV";
-        }
-        else {
-            type = "Unknown";
-        }
-
-        vFile << type << " " << vehicle->getVehicleID() << " " << std::quoted(vehicle->getMake()) << " "
+        vFile << vehicle->getTypeName() << " " << vehicle->getVehicleID() << " " << std::quoted(vehicle->getMake()) << " "
               << std::quoted(vehicle->getModel()) << " " << vehicle->getPassengers() << " "
               << vehicle->getCapacity() << " " << vehicle->getAvailability() << "\n";
     }
@@ -461,8 +505,7 @@ void RentalCompany::saveToFile(const std::string& vehiclesFile, const std::strin
         throw std::runtime_error("Error: Could not open customers file for writing.");
     }
 
-    auto customers = customerRepository.getAll();
-    for (const auto& customer : customers) {
+    for (const auto& customer : customerRepository.getAll()) {
         cFile << customer->getCustomerID() << " " << std::quoted(customer->getName()) << " " << customer->getLoyaltyPoints();
         for (const auto& rental : customer->getRentedVehicles()) {
             cFile << " " << rental.vehicle->getVehicleID();
@@ -473,7 +516,9 @@ void RentalCompany::saveToFile(const std::string& vehiclesFile, const std::strin
 
 /**
  * The function `searchVehicles` filters vehicles based on search criteria and returns a vector of
- * shared pointers to matching vehicles.
+ * shared pointers to matching vehicles. The criteria are compiled into a `VehicleQueryPlan`, which
+ * runs the cheap and selective filters first and the edit-distance filters last; repeated and
+ * refined searches are answered from the result cache (see `matchingPositions`).
  *
  * @param criteria The `searchVehicles` function in the `RentalCompany` class takes a `SearchCriteria`
  * object as a parameter. The `SearchCriteria` object contains the following fields:
@@ -482,25 +527,321 @@ void RentalCompany::saveToFile(const std::string& vehiclesFile, const std::strin
  * the SearchCriteria object.
  */
 std::vector<std::shared_ptr<Vehicle>> RentalCompany::searchVehicles(const SearchCriteria& criteria) const {
-    auto vehicles = vehicleRepository.getAll();
+    const auto& vehicles = vehicleRepository.getAll();
+    const std::vector<std::size_t> positions = matchingPositions(criteria);
+
     std::vector<std::shared_ptr<Vehicle>> results;
+    results.reserve(positions.size());
+    for (std::size_t position : positions) {
+        results.push_back(vehicles[position]);
+    }
+    return results;
+}
 
-    for (const auto& vehicle : vehicles) {
-        bool matches = true;
-        if (!criteria.make.empty() && levenshteinDistance(vehicle->getMake(), criteria.make) > criteria.maxDistanceMake) matches = false;
-        if (!criteria.model.empty() && levenshteinDistance(vehicle->getModel(), criteria.model) > criteria.maxDistanceModel) matches = false;
-        if (criteria.passengerCapacity != -1 && vehicle->getPassengers() != criteria.passengerCapacity) matches = false;
-        if (criteria.storageCapacity != -1 && vehicle->getCapacity() != criteria.storageCapacity) matches = false;
-        if (criteria.filterByAvailability && vehicle->getAvailability() != criteria.availability) matches = false;
-
-        if (matches) {
-            results.push_back(vehicle);
+/**
+ * The function `searchVehiclesBatch` compiles every criteria object into a query plan and runs
+ * them together with `VehicleQueryPlan::executeBatch`, so a large batch reads the fleet once
+ * instead of once per query. The search cache is bypassed: a batch of thousands of distinct
+ * queries would only evict the interactive searches it holds.
+ *
+ * @param criteria The `criteria` parameter is the list of searches to run.
+ *
+ * @return One vector of matching vehicles per entry of `criteria`, each equal to what
+ * `searchVehicles` returns for it.
+ */
+std::vector<std::vector<std::shared_ptr<Vehicle>>> RentalCompany::searchVehiclesBatch(const std::vector<SearchCriteria>& criteria) const {
+    std::vector<VehicleQueryPlan> plans;
+    plans.reserve(criteria.size());
+    for (const auto& query : criteria) {
+        plans.emplace_back(query);
+    }
+
+    const auto& vehicles = vehicleRepository.getAll();
+    std::vector<std::vector<std::shared_ptr<Vehicle>>> results(criteria.size());
+    const std::vector<std::vector<std::size_t>> positions = VehicleQueryPlan::executeBatch(plans, vehicleRepository);
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        results[i].reserve(positions[i].size());
+        for (std::size_t position : positions[i]) {
+            results[i].push_back(vehicles[position]);
         }
     }
+    return results;
+}
 
+/**
+ * The function `searchVehiclesRanked` runs the same compiled plan as `searchVehicles` but keeps
+ * only the `limit` best matches, scored by make/model edit distance plus how closely the vehicle
+ * fits the requested capacities.
+ *
+ * @param criteria The `criteria` parameter holds the search criteria.
+ * @param limit The `limit` parameter is the number of matches to return.
+ *
+ * @return Up to `limit` ranked vehicles, best first.
+ */
+std::vector<RankedResult<Vehicle>> RentalCompany::searchVehiclesRanked(const SearchCriteria& criteria, std::size_t limit) const {
+    const auto& vehicles = vehicleRepository.getAll();
+    std::vector<RankedResult<Vehicle>> results;
+    for (const auto& ranked : VehicleQueryPlan(criteria).executeRanked(vehicleRepository, limit)) {
+        results.push_back(RankedResult<Vehicle>{ vehicles[ranked.second], ranked.first });
+    }
     return results;
 }
 
+/**
+ * The function `findVehicles` returns a cursor over the vehicles matching `criteria`. If the same
+ * search on the unchanged fleet is in the result cache, the cursor streams its positions;
+ * otherwise it is the lazy `VehicleQueryPlan::cursor`, which filters rows only as they are read,
+ * so showing the first page never runs the full search. Only `searchVehicles` fills the cache.
+ *
+ * @param criteria The `criteria` parameter holds the search criteria.
+ *
+ * @return A cursor yielding the matching vehicles in fleet order.
+ */
+SearchCursor<Vehicle> RentalCompany::findVehicles(const SearchCriteria& criteria) const {
+    const VehicleQueryPlan plan(criteria);
+    const std::string key = std::to_string(fleetVersion) + "/" + plan.cacheKey();
+    {
+        std::lock_guard<std::mutex> lock(searchCacheMutex);
+        if (const CachedSearch* cached = searchCache.find(key)) {
+            return SearchCursor<Vehicle>(vehicleRepository.getAll(), cached->positions, nullptr);
+        }
+    }
+    return plan.cursor(vehicleRepository);
+}
+
+/**
+ * The function `matchingPositions` runs a vehicle search through the result cache. Entries are
+ * keyed by the fleet version and the normalised plan, so any fleet change makes older entries
+ * unreachable (they age out of the LRU). On a miss, a cached result on the current version whose
+ * criteria this search only tightens is narrowed instead of searching the fleet, provided it has
+ * fewer rows than the plan's own best index would start from; the answer is cached either way.
+ * The cache lock is only held to look entries up and to store the result, never during the scan,
+ * so concurrent searches run in parallel.
+ *
+ * @param criteria The `criteria` parameter holds the search criteria.
+ *
+ * @return The positions of the matching vehicles in `vehicleRepository.getAll()`, ascending.
+ */
+std::vector<std::size_t> RentalCompany::matchingPositions(const SearchCriteria& criteria) const {
+    const VehicleQueryPlan plan(criteria);
+    const std::string version = std::to_string(fleetVersion) + "/";
+    const std::string key = version + plan.cacheKey();
+
+    // The smallest cached result on this version that is known to contain every match, copied
+    // out so the search below runs without the lock
+    bool narrowed = false;
+    std::vector<std::size_t> broader;
+    {
+        std::lock_guard<std::mutex> lock(searchCacheMutex);
+        if (const CachedSearch* cached = searchCache.find(key)) {
+            return cached->positions;
+        }
+        const CachedSearch* smallest = nullptr;
+        searchCache.forEach([&](const std::string& cachedKey, const CachedSearch& cached) {
+            if (cachedKey.compare(0, version.size(), version) == 0 && plan.refines(cached.plan)
+                && (smallest == nullptr || cached.positions.size() < smallest->positions.size())) {
+                smallest = &cached;
+            }
+        });
+        if (smallest != nullptr && smallest->positions.size() < plan.estimateMatches(vehicleRepository)) {
+            broader = smallest->positions;
+            narrowed = true;
+        }
+    }
+
+    std::vector<std::size_t> positions = narrowed ? plan.executeWithin(vehicleRepository, std::move(broader))
+                                                  : plan.execute(vehicleRepository);
+    std::lock_guard<std::mutex> lock(searchCacheMutex);
+    searchCache.put(key, CachedSearch{ plan, positions });
+    return positions;
+}
+
+/**
+ * The function `completeMake` suggests makes for a partly typed one, from the prefix trie the
+ * vehicle repository keeps over its make column.
+ *
+ * @param prefix The `prefix` parameter is the text typed so far.
+ * @param limit The `limit` parameter is the number of suggestions wanted.
+ *
+ * @return The most common matching makes with their vehicle counts.
+ */
+std::vector<Completion> RentalCompany::completeMake(const std::string& prefix, std::size_t limit) const {
+    return vehicleRepository.completeMake(prefix, limit);
+}
+
+/**
+ * The function `completeModel` suggests models for a partly typed one, from the prefix trie the
+ * vehicle repository keeps over its model column.
+ *
+ * @param prefix The `prefix` parameter is the text typed so far.
+ * @param limit The `limit` parameter is the number of suggestions wanted.
+ *
+ * @return The most common matching models with their vehicle counts.
+ */
+std::vector<Completion> RentalCompany::completeModel(const std::string& prefix, std::size_t limit) const {
+    return vehicleRepository.completeModel(prefix, limit);
+}
+
+/**
+ * The function `completeCustomerName` suggests customer names for a partly typed one, from the
+ * prefix trie the customer repository keeps over names.
+ *
+ * @param prefix The `prefix` parameter is the text typed so far.
+ * @param limit The `limit` parameter is the number of suggestions wanted.
+ *
+ * @return The most common matching names with their customer counts.
+ */
+std::vector<Completion> RentalCompany::completeCustomerName(const std::string& prefix, std::size_t limit) const {
+    return customerRepository.completeName(prefix, limit);
+}
+
+/**
+ * The function `setSearchCacheCapacity` resizes the vehicle search result cache, dropping the least
+ * recently used entries if it shrinks. A capacity of 0 turns caching off.
+ *
+ * @param entries The `entries` parameter is the number of results to keep.
+ */
+void RentalCompany::setSearchCacheCapacity(std::size_t entries) {
+    std::lock_guard<std::mutex> lock(searchCacheMutex);
+    searchCache.setCapacity(entries);
+}
+
+/**
+ * The function `subscribe` registers a standing query and reports its current result as the first
+ * delta, so a subscriber that applies every delta it receives always holds the query's result.
+ *
+ * @param criteria The `criteria` parameter is the search to keep up to date.
+ * @param callback The `callback` parameter receives the query's ID and each non-empty delta.
+ *
+ * @return The ID of the new standing query.
+ */
+SubscriptionId RentalCompany::subscribe(const SearchCriteria& criteria, SearchDeltaCallback callback) {
+    const SubscriptionId id = nextSubscription++;
+    auto it = standingQueries.emplace(id, StandingQuery(criteria, std::move(callback))).first;
+    SearchDelta initial;
+    initial.added = searchVehicles(criteria);
+    it->second.notify(id, initial);
+    return id;
+}
+
+/**
+ * The function `unsubscribe` removes a standing query; it receives no further deltas.
+ *
+ * @param id The `id` parameter is the ID returned by `subscribe`.
+ *
+ * @return True if a query with that ID was registered.
+ */
+bool RentalCompany::unsubscribe(SubscriptionId id) {
+    return standingQueries.erase(id) > 0;
+}
+
+/**
+ * The function `standingMatches` checks one vehicle of the fleet against every standing query.
+ *
+ * @param vehicle The `vehicle` parameter is the vehicle to check; it must be in the repository.
+ *
+ * @return The IDs of the standing queries the vehicle matches, in ascending order (empty if there
+ * are no standing queries or the vehicle is not in the repository).
+ */
+std::vector<SubscriptionId> RentalCompany::standingMatches(const std::shared_ptr<Vehicle>& vehicle) {
+    std::vector<SubscriptionId> ids;
+    if (standingQueries.empty()) {
+        return ids;
+    }
+    const std::size_t row = vehicleRepository.positionOf(vehicle->getVehicleID());
+    if (row == vehicleRepository.getAll().size() || vehicleRepository.getAll()[row] != vehicle) {
+        return ids;
+    }
+    for (auto& entry : standingQueries) {
+        if (entry.second.matches(vehicleRepository.getColumns(), row)) {
+            ids.push_back(entry.first);
+        }
+    }
+    return ids;
+}
+
+/**
+ * The function `publishChange` reports a change to one vehicle: it is added to the queries it
+ * matches now but did not match before, and removed from the ones it no longer matches.
+ *
+ * @param vehicle The `vehicle` parameter is the vehicle that changed.
+ * @param before The `before` parameter is the ascending list of queries it matched before the change.
+ * @param after The `after` parameter is the ascending list of queries it matches after the change.
+ */
+void RentalCompany::publishChange(const std::shared_ptr<Vehicle>& vehicle, const std::vector<SubscriptionId>& before,
+                                  const std::vector<SubscriptionId>& after) {
+    std::map<SubscriptionId, SearchDelta> deltas;
+    std::vector<SubscriptionId> changed;
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(changed));
+    for (SubscriptionId id : changed) {
+        deltas[id].removed.push_back(vehicle);
+    }
+    changed.clear();
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(changed));
+    for (SubscriptionId id : changed) {
+        deltas[id].added.push_back(vehicle);
+    }
+    publishDeltas(deltas);
+}
+
+/**
+ * The function `publishDeltas` hands each delta to its standing query. A callback may unsubscribe
+ * queries, so each one is looked up again just before it is notified.
+ *
+ * @param deltas The `deltas` parameter maps standing query IDs to their changes.
+ */
+void RentalCompany::publishDeltas(const std::map<SubscriptionId, SearchDelta>& deltas) {
+    for (const auto& entry : deltas) {
+        auto it = standingQueries.find(entry.first);
+        if (it != standingQueries.end()) {
+            it->second.notify(entry.first, entry.second);
+        }
+    }
+}
+
+/**
+ * The function `fleetChanged` records a change to the fleet by bumping the version that every
+ * cached search result is keyed by.
+ */
+void RentalCompany::fleetChanged() {
+    ++fleetVersion;
+}
+
+/**
+ * The function `forEachMatchingCustomer` passes every customer matching `criteria`, in repository
+ * order, to `visit` together with the customer's bounded name distance (0 without a name). A fuzzy
+ * name search only verifies the customers the trigram index cannot rule out, and their distances
+ * are computed in one batched call.
+ *
+ * @param criteria The `criteria` parameter holds the customer ID and name to search for.
+ * @param visit The `visit` parameter is called as `visit(customer, distance)` and returns false to
+ * stop the walk.
+ */
+template <typename Visitor>
+void RentalCompany::forEachMatchingCustomer(const CustomerSearchCriteria& criteria, Visitor visit) const {
+    std::vector<std::shared_ptr<Customer>> candidates;
+    const bool narrowed = !criteria.name.empty() && customerRepository.findNameCandidates(criteria.name, criteria.maxDistance, candidates);
+    const auto& customers = narrowed ? candidates : customerRepository.getAll();
+
+    std::vector<std::size_t> distances(customers.size(), 0);
+    if (!criteria.name.empty()) {
+        std::vector<std::string_view> names;
+        names.reserve(customers.size());
+        for (const auto& customer : customers) {
+            names.push_back(customer->getName());
+        }
+        boundedLevenshteinDistances(criteria.name, names, criteria.maxDistance, distances);
+    }
+
+    for (std::size_t i = 0; i < customers.size(); ++i) {
+        if (criteria.customerID != -1 && customers[i]->getCustomerID() != criteria.customerID) continue;
+        if (distances[i] > criteria.maxDistance) continue;
+        if (!visit(customers[i], distances[i])) {
+            return;
+        }
+    }
+}
+
 /**
  * The function `searchCustomers` in the `RentalCompany` class searches for customers based on the
  * provided criteria and returns a vector of shared pointers to matching customers.
@@ -515,27 +856,88 @@ std::vector<std::shared_ptr<Vehicle>> RentalCompany::searchVehicles(const Search
  */
 
 std::vector<std::shared_ptr<Customer>> RentalCompany::searchCustomers(const CustomerSearchCriteria& criteria) const {
-    auto customers = customerRepository.getAll();
     std::vector<std::shared_ptr<Customer>> results;
+    forEachMatchingCustomer(criteria, [&](const std::shared_ptr<Customer>& customer, std::size_t) {
+        results.push_back(customer);
+        return true;
+    });
+    return results;
+}
 
-    for (const auto& customer : customers) {
-        bool matches = true;
-        if (criteria.customerID != -1 && customer->getCustomerID() != criteria.customerID) matches = false;
-        if (!criteria.name.empty() && levenshteinDistance(customer->getName(), criteria.name) > criteria.maxDistance) matches = false;
-
-        if (matches) {
-            results.push_back(customer);
-        }
+/**
+ * The function `findCustomers` returns a lazy cursor over the customers matching `criteria`. A
+ * name search starts from the trigram index's candidates where it can narrow the query (held as
+ * plain pointers, so no ownership is shared), and each candidate's ID and bounded name distance
+ * are checked only when the cursor reaches it.
+ *
+ * @param criteria The `criteria` parameter holds the customer ID and name to search for.
+ *
+ * @return A cursor yielding the matching customers in repository order.
+ */
+SearchCursor<Customer> RentalCompany::findCustomers(const CustomerSearchCriteria& criteria) const {
+    SearchCursor<Customer>::Predicate keep = [criteria](std::size_t, const Customer& customer) {
+        if (criteria.customerID != -1 && customer.getCustomerID() != criteria.customerID) return false;
+        if (!criteria.name.empty() && boundedLevenshteinDistance(criteria.name, customer.getName(), criteria.maxDistance) > criteria.maxDistance) return false;
+        return true;
+    };
+
+    std::vector<const Customer*> candidates;
+    if (!criteria.name.empty() && customerRepository.findNameCandidates(criteria.name, criteria.maxDistance, candidates)) {
+        return SearchCursor<Customer>(std::move(candidates), std::move(keep));
     }
+    return SearchCursor<Customer>(customerRepository.getAll(), std::move(keep));
+}
+
+/**
+ * The function `searchCustomersRanked` keeps the `limit` customers whose names are closest to
+ * `criteria.name`. The matches go straight into a bounded heap scored by name distance, so memory
+ * stays O(limit), and the walk stops once `limit` exact names have been found, since nothing can
+ * beat them. Ties keep repository order.
+ *
+ * @param criteria The `criteria` parameter holds the customer ID and name to search for.
+ * @param limit The `limit` parameter is the number of matches to return.
+ *
+ * @return Up to `limit` ranked customers, closest name first.
+ */
+std::vector<RankedResult<Customer>> RentalCompany::searchCustomersRanked(const CustomerSearchCriteria& criteria, std::size_t limit) const {
+    TopK<std::shared_ptr<Customer>> best(limit);
+    forEachMatchingCustomer(criteria, [&](const std::shared_ptr<Customer>& customer, std::size_t distance) {
+        best.push(static_cast<double>(distance), customer);
+        return best.wouldAccept(0.0);
+    });
 
+    std::vector<RankedResult<Customer>> results;
+    for (auto& ranked : best.takeSorted()) {
+        results.push_back(RankedResult<Customer>{ std::move(ranked.second), ranked.first });
+    }
     return results;
 }
 
 /**
  * The clearData function clears the data stored in the vehicle and customer repositories of a rental
- * company.
+ * company, then releases the slab arenas that held the vehicle and customer objects.
  */
 void RentalCompany::clearData() {
+    // Every vehicle leaves every standing query's result
+    std::map<SubscriptionId, SearchDelta> deltas;
+    if (!standingQueries.empty()) {
+        const auto& all = vehicleRepository.getAll();
+        const VehicleColumns& columns = vehicleRepository.getColumns();
+        for (auto& entry : standingQueries) {
+            for (std::size_t row = 0; row < all.size(); ++row) {
+                if (entry.second.matches(columns, row)) {
+                    deltas[entry.first].removed.push_back(all[row]);
+                }
+            }
+        }
+    }
+
     vehicleRepository.clear();
+    fleetChanged();
     customerRepository.clear();
+    publishDeltas(deltas);
+    deltas.clear();
+
+    // With the repositories empty the object arenas can hand their slabs back in one go
+    ObjectPools::releaseUnused();
 }
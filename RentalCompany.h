@@ -2,15 +2,33 @@
 #ifndef RENTALCOMPANY_H
 #define RENTALCOMPANY_H
 
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <memory>
+#include "LruCache.h"
+#include "QueryPlan.h"
 #include "Repository.h"
 #include "Vehicle.h"
 #include "Customer.h"
 #include "SearchCriteria.h"
+#include "SearchCursor.h"
+#include "StandingQuery.h"
+#include "TopK.h"
 
 // RentalCompany class definition
+//
+// Every change that can alter a vehicle search result (adding, removing, renting or returning a
+// vehicle, loading, clearing) increments the fleet version. Vehicle search results are cached in a
+// small LRU keyed by the normalised query plan and the fleet version, so repeating a search on an
+// unchanged fleet is a lookup, and a search that only adds constraints to a cached one narrows the
+// cached rows instead of scanning the fleet again.
+//
+// Standing queries registered with subscribe() are kept up to date the other way round: each change
+// checks only the vehicles it touched against the registered queries and reports the vehicles that
+// entered or left each query's result.
 class RentalCompany {
 public:
     /**
@@ -48,6 +66,14 @@ public:
      */
     void addVehicle(const std::shared_ptr<Vehicle>& vehicle);
 
+    /**
+     * @brief Add a batch of vehicles to the repository in a single pass
+     *
+     * @param vehicles The vehicles to add
+     * @return std::vector<std::string> The IDs of vehicles skipped because the ID already exists
+     */
+    std::vector<std::string> addVehicles(const std::vector<std::shared_ptr<Vehicle>>& vehicles);
+
     /**
      * @brief Remove a vehicle from the repository by its ID
      *
@@ -73,6 +99,38 @@ public:
      */
     std::vector<std::shared_ptr<Vehicle>> searchVehicles(const SearchCriteria& criteria) const;
 
+    /**
+     * @brief Run many vehicle searches together
+     *
+     * Gives the same results as calling searchVehicles for each criteria object, but the searches
+     * share one pass over the fleet and their fuzzy make/model distances. Results are not taken
+     * from or added to the search cache.
+     *
+     * @param criteria The search criteria, one per query
+     * @return std::vector<std::vector<std::shared_ptr<Vehicle>>> The matching vehicles, one list per query
+     */
+    std::vector<std::vector<std::shared_ptr<Vehicle>>> searchVehiclesBatch(const std::vector<SearchCriteria>& criteria) const;
+
+    /**
+     * @brief Search for vehicles and keep only the best-ranked matches
+     *
+     * @param criteria The search criteria
+     * @param limit The number of matches to return
+     * @return std::vector<RankedResult<Vehicle>> Up to `limit` matches, best (lowest score) first
+     */
+    std::vector<RankedResult<Vehicle>> searchVehiclesRanked(const SearchCriteria& criteria, std::size_t limit = DEFAULT_RANKED_LIMIT) const;
+
+    /**
+     * @brief Search for vehicles lazily
+     *
+     * The cursor yields the same vehicles as searchVehicles, evaluating the criteria only as
+     * results are read. It must not be used after the fleet changes.
+     *
+     * @param criteria The search criteria
+     * @return SearchCursor<Vehicle> A cursor over the matching vehicles
+     */
+    SearchCursor<Vehicle> findVehicles(const SearchCriteria& criteria) const;
+
     /**
      * @brief Search for a vehicle by its ID
      *
@@ -115,6 +173,26 @@ public:
      */
     std::vector<std::shared_ptr<Customer>> searchCustomers(const CustomerSearchCriteria& criteria) const;
 
+    /**
+     * @brief Search for customers and keep only the closest name matches
+     *
+     * @param criteria The search criteria
+     * @param limit The number of matches to return
+     * @return std::vector<RankedResult<Customer>> Up to `limit` matches, closest name first
+     */
+    std::vector<RankedResult<Customer>> searchCustomersRanked(const CustomerSearchCriteria& criteria, std::size_t limit = DEFAULT_RANKED_LIMIT) const;
+
+    /**
+     * @brief Search for customers lazily
+     *
+     * The cursor yields the same customers as searchCustomers, evaluating the criteria only as
+     * results are read. It must not be used after the customer list changes.
+     *
+     * @param criteria The search criteria
+     * @return SearchCursor<Customer> A cursor over the matching customers
+     */
+    SearchCursor<Customer> findCustomers(const CustomerSearchCriteria& criteria) const;
+
     /**
      * @brief Search for a customer by their ID
      *
@@ -174,10 +252,98 @@ public:
      */
     const Repository<Customer>& getCustomerRepository() const { return customerRepository; }
 
+    // Autocomplete
+
+    /**
+     * @brief Complete a partly typed make
+     *
+     * @param prefix The prefix typed so far
+     * @param limit The number of completions wanted (at most PrefixIndex::MAX_COMPLETIONS)
+     * @return std::vector<Completion> Makes starting with `prefix` and their vehicle counts, most common first
+     */
+    std::vector<Completion> completeMake(const std::string& prefix, std::size_t limit = PrefixIndex::MAX_COMPLETIONS) const;
+
+    /**
+     * @brief Complete a partly typed model
+     *
+     * @param prefix The prefix typed so far
+     * @param limit The number of completions wanted (at most PrefixIndex::MAX_COMPLETIONS)
+     * @return std::vector<Completion> Models starting with `prefix` and their vehicle counts, most common first
+     */
+    std::vector<Completion> completeModel(const std::string& prefix, std::size_t limit = PrefixIndex::MAX_COMPLETIONS) const;
+
+    /**
+     * @brief Complete a partly typed customer name
+     *
+     * @param prefix The prefix typed so far
+     * @param limit The number of completions wanted (at most PrefixIndex::MAX_COMPLETIONS)
+     * @return std::vector<Completion> Names starting with `prefix` and their customer counts, most common first
+     */
+    std::vector<Completion> completeCustomerName(const std::string& prefix, std::size_t limit = PrefixIndex::MAX_COMPLETIONS) const;
+
+    // Search result cache
+
+    /**
+     * @brief Get the fleet version
+     *
+     * @return std::uint64_t A counter incremented by every change that can alter a vehicle search
+     */
+    std::uint64_t getFleetVersion() const { return fleetVersion; }
+
+    /**
+     * @brief Set how many vehicle search results are cached
+     *
+     * @param entries The cache capacity (0 disables the cache)
+     */
+    void setSearchCacheCapacity(std::size_t entries);
+
+    /**
+     * @brief Register a standing vehicle search
+     *
+     * The callback is called straight away with the current matches as additions, and then after
+     * every change to the fleet (adding, removing, renting, returning, loading or clearing vehicles)
+     * that adds vehicles to or removes them from the result. Only the vehicles a change touches are
+     * checked against the query. Callbacks run once the change has been applied.
+     *
+     * @param criteria The search criteria
+     * @param callback Receives the query's ID and each non-empty delta
+     * @return SubscriptionId The ID to pass to unsubscribe
+     */
+    SubscriptionId subscribe(const SearchCriteria& criteria, SearchDeltaCallback callback);
+
+    /**
+     * @brief Remove a standing vehicle search
+     *
+     * @param id The ID returned by subscribe
+     * @return bool True if the query was registered
+     */
+    bool unsubscribe(SubscriptionId id);
+
 private:
+    // A cached vehicle search: the plan (to recognise refinements) and its matching positions
+    struct CachedSearch {
+        VehicleQueryPlan plan;
+        std::vector<std::size_t> positions;
+    };
+
+    std::vector<std::size_t> matchingPositions(const SearchCriteria& criteria) const;
+    template <typename Visitor>
+    void forEachMatchingCustomer(const CustomerSearchCriteria& criteria, Visitor visit) const;
+    void fleetChanged();
+    std::vector<SubscriptionId> standingMatches(const std::shared_ptr<Vehicle>& vehicle);
+    void publishChange(const std::shared_ptr<Vehicle>& vehicle, const std::vector<SubscriptionId>& before,
+                       const std::vector<SubscriptionId>& after);
+    void publishDeltas(const std::map<SubscriptionId, SearchDelta>& deltas);
+
     // Repositories for storing vehicles and customers
     Repository<Vehicle> vehicleRepository;
     Repository<Customer> customerRepository;
+
+    std::uint64_t fleetVersion = 0;                                                 // Bumped on every fleet change
+    mutable std::mutex searchCacheMutex;                                            // Guards searchCache
+    mutable LruCache<std::string, CachedSearch> searchCache{ DEFAULT_SEARCH_CACHE_ENTRIES }; // (version, plan key) -> result
+    std::map<SubscriptionId, StandingQuery> standingQueries;                        // Registered standing searches
+    SubscriptionId nextSubscription = 1;                                            // ID for the next subscribe()
 };
 
 #endif // RENTALCOMPANY_H
\ No newline at end of file
@@ -2,9 +2,16 @@
 #ifndef REPOSITORY_H
 #define REPOSITORY_H
 
+#include <array>
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <string>
+#include <unordered_map>
+#include "Handle.h"
+#include "PrefixIndex.h"
+#include "TrigramIndex.h"
+#include "VehicleColumns.h"
 #include "Customer.h"
 #include "Vehicle.h"
 
@@ -65,6 +72,13 @@ private:
 };
 
 // Specialization for Customer
+//
+// Valid customer IDs fall in the small range MIN_CUSTOMER_ID..MAX_CUSTOMER_ID, so customers are
+// found through a direct-address table indexed by `id - MIN_CUSTOMER_ID`: one array slot per
+// possible ID, holding the customer itself. Customers loaded with an ID outside that range (the
+// files are not validated) fall back to a hash map. As with vehicles, the first customer added
+// under an ID is the one returned by findById. Customer names are also kept in a trigram index so
+// fuzzy name searches only verify a small candidate set, and in a prefix trie for autocomplete.
 template <>
 class Repository<Customer> {
 public:
@@ -74,6 +88,17 @@ public:
      * @param item The customer to add
      */
     void add(const std::shared_ptr<Customer>& item) {
+        const int id = item->getCustomerID();
+        if (inDirectRange(id)) {
+            auto& entry = directTable[directSlot(id)];
+            if (!entry) {
+                entry = item;
+            }
+        } else {
+            overflow.emplace(id, item);
+        }
+        nameIndex.insert(item, item->getName());
+        namePrefixes.insert(item->getName());
         items.push_back(item);
     }
 
@@ -83,6 +108,22 @@ public:
      * @param item The customer to remove
      */
     void remove(const std::shared_ptr<Customer>& item) {
+        const int id = item->getCustomerID();
+        if (inDirectRange(id)) {
+            auto& entry = directTable[directSlot(id)];
+            if (entry == item) {
+                entry.reset();
+            }
+        } else {
+            auto it = overflow.find(id);
+            if (it != overflow.end() && it->second == item) {
+                overflow.erase(it);
+            }
+        }
+        for (auto n = std::count(items.begin(), items.end(), item); n > 0; --n) {
+            namePrefixes.erase(item->getName());
+        }
+        nameIndex.erase(item);
         items.erase(std::remove(items.begin(), items.end(), item), items.end());
     }
 
@@ -93,11 +134,46 @@ public:
      * @return std::shared_ptr<Customer> The customer with the specified ID, or nullptr if not found
      */
     std::shared_ptr<Customer> findById(int id) const {
-        auto it = std::find_if(items.begin(), items.end(),
-            [&id](const std::shared_ptr<Customer>& item) {
-                return item->getCustomerID() == id;
-            });
-        return (it != items.end()) ? *it : nullptr;
+        if (inDirectRange(id)) {
+            return directTable[directSlot(id)];
+        }
+        auto it = overflow.find(id);
+        return (it != overflow.end()) ? it->second : nullptr;
+    }
+
+    /**
+     * @brief Find the customers whose name may be within `maxDistance` edits of `name`
+     *
+     * @param name The name to search for
+     * @param maxDistance The largest edit distance of interest
+     * @param candidates Receives the candidates in getAll() order; each must still be checked with an exact distance
+     * @return bool False if the index cannot narrow this query and every customer must be checked
+     */
+    bool findNameCandidates(const std::string& name, std::size_t maxDistance, std::vector<std::shared_ptr<Customer>>& candidates) const {
+        return nameIndex.search(name, maxDistance, candidates);
+    }
+
+    /**
+     * @brief Find the customers whose name may be within `maxDistance` edits of `name`, without sharing ownership
+     *
+     * @param name The name to search for
+     * @param maxDistance The largest edit distance of interest
+     * @param candidates Receives pointers to the candidates in getAll() order; each must still be checked with an exact distance
+     * @return bool False if the index cannot narrow this query and every customer must be checked
+     */
+    bool findNameCandidates(const std::string& name, std::size_t maxDistance, std::vector<const Customer*>& candidates) const {
+        return nameIndex.search(name, maxDistance, candidates);
+    }
+
+    /**
+     * @brief Get the most common customer names starting with `prefix`
+     *
+     * @param prefix The prefix typed so far
+     * @param limit The number of completions wanted (at most PrefixIndex::MAX_COMPLETIONS)
+     * @return std::vector<Completion> Names and how many customers have each, most common first
+     */
+    std::vector<Completion> completeName(std::string_view prefix, std::size_t limit = PrefixIndex::MAX_COMPLETIONS) const {
+        return namePrefixes.complete(prefix, limit);
     }
 
     /**
@@ -114,13 +190,45 @@ public:
      */
     void clear() {
         items.clear();
+        for (auto& entry : directTable) {
+            entry.reset();
+        }
+        overflow.clear();
+        nameIndex.clear();
+        namePrefixes.clear();
     }
 
 private:
-    std::vector<std::shared_ptr<Customer>> items; // Vector to store customers
+    static constexpr std::size_t DIRECT_TABLE_SIZE = static_cast<std::size_t>(MAX_CUSTOMER_ID - MIN_CUSTOMER_ID + 1);
+
+    static bool inDirectRange(int id) {
+        return id >= MIN_CUSTOMER_ID && id <= MAX_CUSTOMER_ID;
+    }
+
+    static std::size_t directSlot(int id) {
+        return static_cast<std::size_t>(id - MIN_CUSTOMER_ID);
+    }
+
+    std::vector<std::shared_ptr<Customer>> items;                              // Vector to store customers
+    std::array<std::shared_ptr<Customer>, DIRECT_TABLE_SIZE> directTable;      // Customer ID - MIN_CUSTOMER_ID -> customer
+    std::unordered_map<int, std::shared_ptr<Customer>> overflow;               // Customers with out-of-range IDs
+    TrigramIndex<Customer> nameIndex;                                          // Fuzzy index over customer names
+    PrefixIndex namePrefixes;                                                  // Autocomplete over customer names
 };
 
 // Specialization for Vehicle
+//
+// Vehicles are looked up by ID on every rental, return, add and remove, so the repository keeps a
+// hash index from vehicle ID to the vehicle's position in `items`. The index is keyed by the
+// packed integer VehicleKey; the rare IDs that cannot be packed are indexed by their text in a
+// separate map. IDs are expected to be unique
+// (RentalCompany::addVehicle enforces this). Removal swaps the last vehicle into the freed
+// position, so it is O(1) but does not preserve the order of getAll(); callers that need to keep
+// a reference across removals hold a generation-checked Handle rather than a position.
+//
+// Alongside the Vehicle objects the repository stores their scalar attributes column-wise (see
+// VehicleColumns) for scan-heavy queries. Availability changes must go through setAvailability()
+// so the columns stay in step with the vehicles.
 template <>
 class Repository<Vehicle> {
 public:
@@ -128,18 +236,121 @@ public:
      * @brief Add a vehicle to the repository
      *
      * @param item The vehicle to add
+     * @return Handle A stable handle to the added vehicle, or an invalid handle if a vehicle with
+     * the same ID is already present (nothing is added)
      */
-    void add(const std::shared_ptr<Vehicle>& item) {
+    Handle add(const std::shared_ptr<Vehicle>& item) {
+        if (!indexInsert(*item, items.size())) {
+            return Handle{};
+        }
+        Handle handle = handles.attach(items.size());
+        columns.push(*item);
         items.push_back(item);
+        return handle;
+    }
+
+    /**
+     * @brief Add a batch of vehicles in a single pass
+     *
+     * Capacity is reserved up front and the ID index doubles as the duplicate check, so the whole
+     * batch costs O(batch size). Vehicles whose ID is already present (in the repository or earlier
+     * in the batch) are skipped.
+     *
+     * @param batch The vehicles to add
+     * @return std::vector<std::string> The IDs of the vehicles that were skipped as duplicates
+     */
+    std::vector<std::string> addAll(const std::vector<std::shared_ptr<Vehicle>>& batch) {
+        std::vector<std::string> duplicates;
+        items.reserve(items.size() + batch.size());
+        keyIndex.reserve(items.size() + batch.size());
+        handles.reserve(items.size() + batch.size());
+        columns.reserve(items.size() + batch.size());
+
+        for (const auto& item : batch) {
+            if (indexInsert(*item, items.size())) {
+                handles.attach(items.size());
+                columns.push(*item);
+                items.push_back(item);
+            } else {
+                duplicates.push_back(item->getVehicleID());
+            }
+        }
+        return duplicates;
     }
 
     /**
-     * @brief Remove a vehicle from the repository
+     * @brief Remove a vehicle from the repository in O(1) (the last vehicle takes its position)
      *
      * @param item The vehicle to remove
      */
     void remove(const std::shared_ptr<Vehicle>& item) {
-        items.erase(std::remove(items.begin(), items.end(), item), items.end());
+        const std::size_t position = indexFind(*item);
+        if (position != NOT_FOUND && items[position] == item) {
+            removeAt(position);
+        }
+    }
+
+    /**
+     * @brief Remove the vehicle a handle refers to
+     *
+     * @param handle The handle of the vehicle to remove
+     * @return bool True if a vehicle was removed, false if the handle was stale
+     */
+    bool remove(const Handle& handle) {
+        const std::size_t position = handles.positionOf(handle);
+        if (position == HandleTable::NPOS) {
+            return false;
+        }
+        removeAt(position);
+        return true;
+    }
+
+    /**
+     * @brief Remove every vehicle matching a predicate, compacting the repository in one pass
+     *
+     * Unlike remove(), the relative order of the remaining vehicles is preserved.
+     *
+     * @tparam Predicate Callable taking `const std::shared_ptr<Vehicle>&` and returning bool
+     * @param predicate Returns true for vehicles to remove
+     * @return std::size_t The number of vehicles removed
+     */
+    template <typename Predicate>
+    std::size_t removeIf(Predicate predicate) {
+        std::size_t kept = 0;
+        for (std::size_t position = 0; position < items.size(); ++position) {
+            if (predicate(items[position])) {
+                indexErase(*items[position]);
+                handles.detach(position);
+                columns.release(position);
+                continue;
+            }
+            if (kept != position) {
+                items[kept] = std::move(items[position]);
+                indexAssign(*items[kept], kept);
+                handles.move(position, kept);
+                columns.moveRow(position, kept);
+            }
+            ++kept;
+        }
+        const std::size_t removed = items.size() - kept;
+        items.resize(kept);
+        handles.truncate(kept);
+        columns.truncate(kept);
+        return removed;
+    }
+
+    /**
+     * @brief Set a vehicle's availability, keeping the availability column in step
+     *
+     * @param item The vehicle to update
+     * @param avail The new availability status
+     */
+    void setAvailability(const std::shared_ptr<Vehicle>& item, bool avail) {
+        item->setAvailability(avail);
+        const std::size_t position = indexFind(*item);
+        if (position != NOT_FOUND && items[position] == item) {
+            columns.setAvailable(position, avail);
+        }
     }
 
     /**
@@ -149,11 +360,52 @@ public:
      * @return std::shared_ptr<Vehicle> The vehicle with the specified ID, or nullptr if not found
      */
     std::shared_ptr<Vehicle> findById(const std::string& id) const {
-        auto it = std::find_if(items.begin(), items.end(),
-            [&id](const std::shared_ptr<Vehicle>& item) {
-                return item->getVehicleID() == id;
-            });
-        return (it != items.end()) ? *it : nullptr;
+        const std::size_t position = indexFind(id);
+        return (position != NOT_FOUND) ? items[position] : nullptr;
+    }
+
+    /**
+     * @brief Get a vehicle's position in getAll() (and its row in the columns)
+     *
+     * @param id The ID of the vehicle
+     * @return std::size_t The position, or getAll().size() if no vehicle has that ID
+     */
+    std::size_t positionOf(const std::string& id) const {
+        const std::size_t position = indexFind(id);
+        return (position != NOT_FOUND) ? position : items.size();
+    }
+
+    /**
+     * @brief Find a vehicle by its packed ID key
+     *
+     * @param key The packed vehicle ID (see packVehicleID)
+     * @return std::shared_ptr<Vehicle> The vehicle with the specified key, or nullptr if not found
+     */
+    std::shared_ptr<Vehicle> findByKey(VehicleKey key) const {
+        auto it = keyIndex.find(key);
+        return (it != keyIndex.end()) ? items[it->second] : nullptr;
+    }
+
+    /**
+     * @brief Get a stable handle to a vehicle by its ID
+     *
+     * @param id The ID of the vehicle
+     * @return Handle The vehicle's handle, or an invalid handle if not found
+     */
+    Handle handleOf(const std::string& id) const {
+        const std::size_t position = indexFind(id);
+        return (position != NOT_FOUND) ? handles.handleAt(position) : Handle{};
+    }
+
+    /**
+     * @brief Resolve a handle to its vehicle
+     *
+     * @param handle The handle to resolve
+     * @return std::shared_ptr<Vehicle> The vehicle, or nullptr if it has been removed since the handle was issued
+     */
+    std::shared_ptr<Vehicle> get(const Handle& handle) const {
+        const std::size_t position = handles.positionOf(handle);
+        return (position != HandleTable::NPOS) ? items[position] : nullptr;
     }
 
     /**
@@ -166,14 +418,157 @@ public:
     }
 
     /**
-     * @brief Clear all vehicles from the repository
+     * @brief Get the column store of vehicle attributes (row `i` describes getAll()[i])
+     *
+     * @return const VehicleColumns& The attribute columns
+     */
+    const VehicleColumns& getColumns() const {
+        return columns;
+    }
+
+    /**
+     * @brief Get the most common makes starting with `prefix`
+     *
+     * @param prefix The prefix typed so far
+     * @param limit The number of completions wanted (at most PrefixIndex::MAX_COMPLETIONS)
+     * @return std::vector<Completion> Makes and how many vehicles have each, most common first
+     */
+    std::vector<Completion> completeMake(std::string_view prefix, std::size_t limit = PrefixIndex::MAX_COMPLETIONS) const {
+        return columns.makePrefixes.complete(prefix, limit);
+    }
+
+    /**
+     * @brief Get the most common models starting with `prefix`
+     *
+     * @param prefix The prefix typed so far
+     * @param limit The number of completions wanted (at most PrefixIndex::MAX_COMPLETIONS)
+     * @return std::vector<Completion> Models and how many vehicles have each, most common first
+     */
+    std::vector<Completion> completeModel(std::string_view prefix, std::size_t limit = PrefixIndex::MAX_COMPLETIONS) const {
+        return columns.modelPrefixes.complete(prefix, limit);
+    }
+
+    /**
+     * @brief Count the available vehicles of one type
+     *
+     * @param type The vehicle type
+     * @return std::size_t The number of available vehicles of that type
+     */
+    std::size_t countAvailable(VehicleType type) const {
+        return columns.availableByType[static_cast<std::size_t>(type)];
+    }
+
+    /**
+     * @brief Count the rented (unavailable) vehicles of one type
+     *
+     * @param type The vehicle type
+     * @return std::size_t The number of rented vehicles of that type
+     */
+    std::size_t countRented(VehicleType type) const {
+        return columns.rentedByType[static_cast<std::size_t>(type)];
+    }
+
+    /**
+     * @brief Get the available vehicles of one type, in repository order
+     *
+     * @param type The vehicle type
+     * @return std::vector<std::shared_ptr<Vehicle>> The available vehicles of that type
+     */
+    std::vector<std::shared_ptr<Vehicle>> findAvailable(VehicleType type) const {
+        std::vector<std::shared_ptr<Vehicle>> result;
+        result.reserve(countAvailable(type));
+        columns.forEachAvailable(type, [&](std::size_t position) { result.push_back(items[position]); });
+        return result;
+    }
+
+    /**
+     * @brief Clear all vehicles from the repository (all outstanding handles become stale)
      */
     void clear() {
         items.clear();
+        keyIndex.clear();
+        textIndex.clear();
+        handles.clear();
+        columns.clear();
     }
 
 private:
-    std::vector<std::shared_ptr<Vehicle>> items; // Vector to store vehicles
+    static constexpr std::size_t NOT_FOUND = HandleTable::NPOS;
+
+    // ID index helpers: packed keys go to `keyIndex`, anything else to `textIndex`
+
+    bool indexInsert(const Vehicle& vehicle, std::size_t position) {
+        const VehicleKey key = vehicle.getVehicleKey();
+        if (key != NO_VEHICLE_KEY) {
+            return keyIndex.emplace(key, position).second;
+        }
+        return textIndex.emplace(vehicle.getVehicleID(), position).second;
+    }
+
+    void indexAssign(const Vehicle& vehicle, std::size_t position) {
+        const VehicleKey key = vehicle.getVehicleKey();
+        if (key != NO_VEHICLE_KEY) {
+            keyIndex[key] = position;
+        } else {
+            textIndex[vehicle.getVehicleID()] = position;
+        }
+    }
+
+    void indexErase(const Vehicle& vehicle) {
+        const VehicleKey key = vehicle.getVehicleKey();
+        if (key != NO_VEHICLE_KEY) {
+            keyIndex.erase(key);
+        } else {
+            textIndex.erase(vehicle.getVehicleID());
+        }
+    }
+
+    std::size_t indexFind(const Vehicle& vehicle) const {
+        const VehicleKey key = vehicle.getVehicleKey();
+        if (key != NO_VEHICLE_KEY) {
+            auto it = keyIndex.find(key);
+            return (it != keyIndex.end()) ? it->second : NOT_FOUND;
+        }
+        auto it = textIndex.find(vehicle.getVehicleID());
+        return (it != textIndex.end()) ? it->second : NOT_FOUND;
+    }
+
+    std::size_t indexFind(const std::string& id) const {
+        const VehicleKey key = packVehicleID(id);
+        if (key != NO_VEHICLE_KEY) {
+            auto it = keyIndex.find(key);
+            return (it != keyIndex.end()) ? it->second : NOT_FOUND;
+        }
+        auto it = textIndex.find(id);
+        return (it != textIndex.end()) ? it->second : NOT_FOUND;
+    }
+
+    /**
+     * @brief Swap-and-pop the vehicle at `position`
+     *
+     * @param position The position of the vehicle to remove
+     */
+    void removeAt(std::size_t position) {
+        const std::size_t last = items.size() - 1;
+        indexErase(*items[position]);
+        handles.detach(position);
+        columns.release(position);
+        if (position != last) {
+            items[position] = std::move(items[last]);
+            indexAssign(*items[position], position);
+            handles.move(last, position);
+            columns.moveRow(last, position);
+        }
+        items.pop_back();
+        handles.truncate(last);
+        columns.truncate(last);
+    }
+
+    std::vector<std::shared_ptr<Vehicle>> items;            // Vector to store vehicles
+    std::unordered_map<VehicleKey, std::size_t> keyIndex;   // Packed vehicle ID -> position in `items`
+    std::unordered_map<std::string, std::size_t> textIndex; // Unpackable vehicle ID -> position in `items`
+    HandleTable handles;                                    // Stable handles -> position in `items`
+    VehicleColumns columns;                                 // Scalar attributes, one row per vehicle
 };
 
 #endif // REPOSITORY_H
\ No newline at end of file
@@ -46,9 +46,9 @@ public:
     /**
      * @brief Get the type of the vehicle
      *
-     * @return std::string The type of the vehicle (SUV)
+     * @return VehicleType The type of the vehicle (VehicleType::SUV)
      */
-    std::string getType() const override { return "SUV"; }
+    VehicleType getType() const override { return VehicleType::SUV; }
 };
 
 #endif // SUV_H
\ No newline at end of file
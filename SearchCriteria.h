@@ -2,8 +2,15 @@
 #ifndef SEARCHCRITERIA_H
 #define SEARCHCRITERIA_H
 
+#include <cstddef>
 #include <string>
 
+// Number of results a ranked search returns by default (what an interactive desk looks at)
+constexpr std::size_t DEFAULT_RANKED_LIMIT = 20;
+
+// Number of vehicle search results RentalCompany keeps cached by default
+constexpr std::size_t DEFAULT_SEARCH_CACHE_ENTRIES = 16;
+
 // The `SearchCriteria` struct defines the criteria for searching vehicles.
 struct SearchCriteria {
     std::string type;              // Type of the vehicle
@@ -13,6 +20,10 @@ struct SearchCriteria {
     size_t maxDistanceModel;       // Maximum Levenshtein distance for model
     int passengerCapacity;         // Minimum passenger capacity
     int storageCapacity;           // Minimum storage capacity
+    int minPassengers;             // Smallest passenger capacity to accept (-1 for no lower bound)
+    int maxPassengers;             // Largest passenger capacity to accept (-1 for no upper bound)
+    int minStorage;                // Smallest storage capacity to accept (-1 for no lower bound)
+    int maxStorage;                // Largest storage capacity to accept (-1 for no upper bound)
     bool filterByAvailability;     // Whether to filter by availability
     bool availability;             // Availability status
 
@@ -21,6 +32,7 @@ struct SearchCriteria {
         : type(""), make(""), model(""),
           maxDistanceMake(2), maxDistanceModel(0),  // Set model maxDistance to 0 for exact match
           passengerCapacity(-1), storageCapacity(-1),
+          minPassengers(-1), maxPassengers(-1), minStorage(-1), maxStorage(-1),
           filterByAvailability(false), availability(false) {}
 };
 
@@ -0,0 +1,171 @@
+// SearchCursor.h
+#ifndef SEARCHCURSOR_H
+#define SEARCHCURSOR_H
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// The `SearchCursor` class is a lazy view of search results. It walks a list of candidates (every
+// item of a repository, some positions in it, or an explicit list of items) and checks each one
+// against a predicate only when the caller asks for the next match, so a caller that stops early
+// never pays for the rest of the scan and nothing is copied up front. Matches are handed out as
+// plain references to the repository's items, so reading results never touches a shared_ptr
+// reference count.
+//
+// skip() and limit() page through the matches: skip(n) discards the next n matches, limit(n) ends
+// the cursor after n more. Both are applied lazily, as the cursor advances.
+//
+// A cursor refers to the repository it was created from and must not outlive it or be used after
+// the repository changes.
+template <typename T>
+class SearchCursor {
+public:
+    // Called with a candidate's row (its position in the repository, or in the explicit candidate
+    // list) and the candidate itself; returns true to keep it. An empty predicate keeps everything.
+    using Predicate = std::function<bool(std::size_t row, const T& item)>;
+
+    /**
+     * @brief Construct a cursor over every item of a repository
+     *
+     * @param source The repository's items
+     * @param predicate The predicate matches must satisfy
+     */
+    SearchCursor(const std::vector<std::shared_ptr<T>>& source, Predicate predicate)
+        : items(&source), allRows(true), keep(std::move(predicate)) {}
+
+    /**
+     * @brief Construct a cursor over some positions of a repository
+     *
+     * @param source The repository's items
+     * @param positions The positions to consider, in the order they should be visited
+     * @param predicate The predicate matches must satisfy
+     */
+    SearchCursor(const std::vector<std::shared_ptr<T>>& source, std::vector<std::size_t> positions, Predicate predicate)
+        : items(&source), rows(std::move(positions)), allRows(false), keep(std::move(predicate)) {}
+
+    /**
+     * @brief Construct a cursor over an explicit list of candidates
+     *
+     * @param list The candidates to consider, in order; rows passed to the predicate index this list
+     * @param predicate The predicate matches must satisfy
+     */
+    SearchCursor(std::vector<const T*> list, Predicate predicate)
+        : candidates(std::move(list)), allRows(false), keep(std::move(predicate)) {}
+
+    /**
+     * @brief Discard the next `count` matches
+     *
+     * @param count The number of matches to skip
+     * @return SearchCursor& This cursor
+     */
+    SearchCursor& skip(std::size_t count) {
+        if (count != 0 && pending != nullptr) {
+            // The match empty() found is the first one skipped
+            pending = nullptr;
+            --count;
+        }
+        toSkip += count;
+        return *this;
+    }
+
+    /**
+     * @brief End the cursor after `count` more matches
+     *
+     * @param count The number of matches still to return
+     * @return SearchCursor& This cursor
+     */
+    SearchCursor& limit(std::size_t count) {
+        remaining = count;
+        return *this;
+    }
+
+    /**
+     * @brief Check whether the cursor has no matches left (evaluates candidates up to the next match)
+     *
+     * @return bool True if next() would return nullptr
+     */
+    bool empty() {
+        return lookAhead() == nullptr;
+    }
+
+    /**
+     * @brief Get the next match
+     *
+     * @return const T* The next matching item, or nullptr once the cursor is exhausted
+     */
+    const T* next() {
+        const T* item = lookAhead();
+        if (item != nullptr) {
+            pending = nullptr;
+            --remaining;
+        }
+        return item;
+    }
+
+    /**
+     * @brief Visit every remaining match in order
+     *
+     * @tparam Visit Callable taking a const T&
+     * @param visit The visitor
+     * @return std::size_t The number of matches visited
+     */
+    template <typename Visit>
+    std::size_t forEach(Visit visit) {
+        std::size_t visited = 0;
+        while (const T* item = next()) {
+            visit(*item);
+            ++visited;
+        }
+        return visited;
+    }
+
+private:
+    // Finds the next match that is not skipped, without consuming it
+    const T* lookAhead() {
+        if (remaining == 0) {
+            return nullptr;
+        }
+        while (pending == nullptr) {
+            const T* item = advance();
+            if (item == nullptr) {
+                return nullptr;
+            }
+            if (toSkip != 0) {
+                --toSkip;
+            } else {
+                pending = item;
+            }
+        }
+        return pending;
+    }
+
+    // Moves past candidates until one satisfies the predicate
+    const T* advance() {
+        const std::size_t count = allRows ? items->size() : (items != nullptr ? rows.size() : candidates.size());
+        while (position < count) {
+            const std::size_t index = position++;
+            const std::size_t row = (allRows || items == nullptr) ? index : rows[index];
+            const T* item = items != nullptr ? (*items)[row].get() : candidates[index];
+            if (!keep || keep(row, *item)) {
+                return item;
+            }
+        }
+        return nullptr;
+    }
+
+    const std::vector<std::shared_ptr<T>>* items = nullptr; // Repository items, if candidates are rows of it
+    std::vector<std::size_t> rows;                          // Positions in items to visit (unless allRows)
+    std::vector<const T*> candidates;                       // Explicit candidates (if items is null)
+    bool allRows;                                           // Visit every position in items
+    Predicate keep;                                         // Match predicate
+    std::size_t position = 0;                               // Next candidate to evaluate
+    const T* pending = nullptr;                             // Match found by lookAhead() but not yet returned
+    std::size_t toSkip = 0;                                 // Matches still to discard
+    std::size_t remaining = std::numeric_limits<std::size_t>::max(); // Matches still to return
+};
+
+#endif // SEARCHCURSOR_H
@@ -0,0 +1,93 @@
+// StandingQuery.h
+#ifndef STANDINGQUERY_H
+#define STANDINGQUERY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "EditDistance.h"
+#include "QueryPlan.h"
+#include "SearchCriteria.h"
+#include "SymbolTable.h"
+#include "Vehicle.h"
+#include "VehicleColumns.h"
+
+// Identifies a standing query registered with RentalCompany::subscribe
+using SubscriptionId = std::uint64_t;
+
+// A change to the result of a standing query
+struct SearchDelta {
+    std::vector<std::shared_ptr<Vehicle>> added;    // Vehicles that now match
+    std::vector<std::shared_ptr<Vehicle>> removed;  // Vehicles that no longer match
+};
+
+// Receives the deltas of one standing query
+using SearchDeltaCallback = std::function<void(SubscriptionId, const SearchDelta&)>;
+
+// The `StandingQuery` class is a vehicle search that stays registered while the fleet changes. It
+// keeps its criteria compiled into a VehicleQueryPlan and, for fuzzy makes and models, a distance
+// cache that lives as long as the query, so checking whether one changed vehicle matches costs a
+// few column compares and, after the first time a make or model is seen, no edit distances.
+//
+// A plan for an exact make or model that no vehicle had when it was compiled can never match, so
+// the plan is recompiled once new strings have been interned in the meantime.
+class StandingQuery {
+public:
+    /**
+     * @brief Construct a standing query
+     *
+     * @param searchCriteria The search criteria
+     * @param onDelta The callback that receives the query's deltas
+     */
+    StandingQuery(const SearchCriteria& searchCriteria, SearchDeltaCallback onDelta)
+        : criteria(searchCriteria), plan(searchCriteria), makeMatches(searchCriteria.make, searchCriteria.maxDistanceMake),
+          modelMatches(searchCriteria.model, searchCriteria.maxDistanceModel), callback(std::move(onDelta)),
+          symbolsSeen(SymbolTable::global().size()) {}
+
+    /**
+     * @brief Check whether one row of the fleet matches the query
+     *
+     * @param columns The repository's attribute columns
+     * @param row The vehicle's position
+     * @return bool True if the vehicle matches
+     */
+    bool matches(const VehicleColumns& columns, std::size_t row) {
+        if (plan.isEmpty() && SymbolTable::global().size() != symbolsSeen) {
+            plan = VehicleQueryPlan(criteria);
+            symbolsSeen = SymbolTable::global().size();
+        }
+        return plan.matchesRow(columns, row, makeMatches, modelMatches);
+    }
+
+    /**
+     * @brief Pass a delta to the subscriber, unless it is empty
+     *
+     * @param id The query's subscription ID
+     * @param delta The change to the query's result
+     */
+    void notify(SubscriptionId id, const SearchDelta& delta) const {
+        if (!delta.added.empty() || !delta.removed.empty()) {
+            callback(id, delta);
+        }
+    }
+
+    /**
+     * @brief Get the query's criteria
+     *
+     * @return const SearchCriteria& The search criteria
+     */
+    const SearchCriteria& getCriteria() const { return criteria; }
+
+private:
+    SearchCriteria criteria;        // The criteria the query was registered with
+    VehicleQueryPlan plan;          // The compiled criteria
+    SymbolMatchCache makeMatches;   // Distances from the fuzzy make, for the query's lifetime
+    SymbolMatchCache modelMatches;  // Distances from the fuzzy model, for the query's lifetime
+    SearchDeltaCallback callback;   // Receives the deltas
+    std::size_t symbolsSeen;        // Interned strings when the plan was compiled
+};
+
+#endif // STANDINGQUERY_H
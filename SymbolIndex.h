@@ -0,0 +1,154 @@
+// SymbolIndex.h
+#ifndef SYMBOLINDEX_H
+#define SYMBOLINDEX_H
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "SymbolTable.h"
+#include "SymbolTrie.h"
+
+// The `SymbolIndex` class is a fuzzy inverted index over one symbol column of VehicleColumns. Each
+// symbol keeps a posting list of the rows that hold it, and the distinct symbols in use are kept in
+// a SymbolTrie, so a fuzzy query finds the close-enough distinct values first and then expands them
+// straight to rows. Each row remembers its slot in its posting list, so insertion, removal and the
+// row moves done by the repository's swap-and-pop are all O(1).
+class SymbolIndex {
+public:
+    /**
+     * @brief Record that row `row` holds `symbol`
+     *
+     * @param symbol The row's symbol
+     * @param row The row (must be the next row, i.e. rows are appended in order)
+     */
+    void insert(Symbol symbol, std::size_t row) {
+        if (symbol >= postings.size()) {
+            postings.resize(static_cast<std::size_t>(symbol) + 1);
+        }
+        auto& rows = postings[symbol];
+        if (rows.empty()) {
+            tree.insert(symbol);
+        }
+        if (row >= slot.size()) {
+            slot.resize(row + 1);
+        }
+        slot[row] = rows.size();
+        rows.push_back(row);
+    }
+
+    /**
+     * @brief Forget that row `row` holds `symbol`
+     *
+     * @param symbol The row's symbol
+     * @param row The row being removed
+     */
+    void erase(Symbol symbol, std::size_t row) {
+        auto& rows = postings[symbol];
+        const std::size_t moved = rows.back();
+        rows[slot[row]] = moved;
+        slot[moved] = slot[row];
+        rows.pop_back();
+        if (rows.empty()) {
+            tree.erase(symbol);
+        }
+    }
+
+    /**
+     * @brief Record that the row holding `symbol` moved from `from` to `to`
+     *
+     * @param symbol The row's symbol
+     * @param from The old row
+     * @param to The new row
+     */
+    void move(Symbol symbol, std::size_t from, std::size_t to) {
+        postings[symbol][slot[from]] = to;
+        slot[to] = slot[from];
+    }
+
+    /**
+     * @brief Drop the bookkeeping for rows from `rows` onwards
+     *
+     * @param rows The new number of rows
+     */
+    void truncate(std::size_t rows) {
+        slot.resize(rows);
+    }
+
+    /**
+     * @brief Reserve room for `rows` rows
+     *
+     * @param rows The expected number of rows
+     */
+    void reserve(std::size_t rows) {
+        slot.reserve(rows);
+    }
+
+    /**
+     * @brief Remove all rows and symbols
+     */
+    void clear() {
+        postings.clear();
+        slot.clear();
+        tree.clear();
+    }
+
+    /**
+     * @brief Get the number of distinct symbols held by at least one row
+     *
+     * @return std::size_t The number of distinct symbols
+     */
+    std::size_t distinctCount() const {
+        return tree.size();
+    }
+
+    /**
+     * @brief Get the rows holding exactly `symbol`
+     *
+     * @param symbol The symbol to look up (may be NO_SYMBOL)
+     * @return const std::vector<std::size_t>& The rows, in no particular order
+     */
+    const std::vector<std::size_t>& rowsOf(Symbol symbol) const {
+        static const std::vector<std::size_t> none;
+        return symbol < postings.size() ? postings[symbol] : none;
+    }
+
+    /**
+     * @brief Call `visit(row)` for every row whose symbol is within `maxDistance` edits of `text`
+     *
+     * Rows are visited grouped by symbol, not in row order.
+     *
+     * @tparam Visitor Callable taking a std::size_t row
+     * @param text The query string
+     * @param maxDistance The largest edit distance to accept
+     * @param visit The visitor
+     */
+    template <typename Visitor>
+    void forEachMatch(std::string_view text, std::size_t maxDistance, Visitor visit) const {
+        std::vector<Symbol> matches;
+        tree.search(text, maxDistance, matches);
+        for (Symbol symbol : matches) {
+            for (std::size_t row : postings[symbol]) {
+                visit(row);
+            }
+        }
+    }
+
+    /**
+     * @brief Find the distinct symbols in use within `maxDistance` edits of `text`
+     *
+     * @param text The query string
+     * @param maxDistance The largest edit distance to accept
+     * @param matches Receives (symbol, exact distance) pairs, in no particular order
+     */
+    void matchingSymbols(std::string_view text, std::size_t maxDistance, std::vector<std::pair<Symbol, std::size_t>>& matches) const {
+        tree.search(text, maxDistance, matches);
+    }
+
+private:
+    SymbolTrie tree;                                // Distinct symbols in use
+    std::vector<std::vector<std::size_t>> postings; // Symbol -> rows holding it
+    std::vector<std::size_t> slot;                  // Row -> index in its symbol's posting list
+};
+
+#endif // SYMBOLINDEX_H
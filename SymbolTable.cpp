@@ -0,0 +1,45 @@
+// SymbolTable.cpp
+#include "SymbolTable.h"
+
+/**
+ * The function `global` returns the single symbol table shared by the whole program. Vehicle makes
+ * and models are interned here so symbols can be compared across vehicles and repositories.
+ *
+ * @return A reference to the global `SymbolTable`.
+ */
+SymbolTable& SymbolTable::global() {
+    static SymbolTable table;
+    return table;
+}
+
+/**
+ * The function `intern` returns the symbol for `text`, storing a copy of the string the first time
+ * it is seen.
+ *
+ * @param text The `text` parameter is the string to intern.
+ *
+ * @return The `Symbol` identifying `text`. Equal strings always get the same symbol.
+ */
+Symbol SymbolTable::intern(std::string_view text) {
+    auto it = symbols.find(text);
+    if (it != symbols.end()) {
+        return it->second;
+    }
+    const Symbol symbol = static_cast<Symbol>(strings.size());
+    strings.emplace_back(text);
+    symbols.emplace(std::string_view(strings.back()), symbol);
+    return symbol;
+}
+
+/**
+ * The function `find` looks up the symbol of `text` without adding it to the table.
+ *
+ * @param text The `text` parameter is the string to look up.
+ *
+ * @return The `Symbol` of `text`, or `NO_SYMBOL` if the string has never been interned (in which
+ * case no vehicle can have it as its make or model).
+ */
+Symbol SymbolTable::find(std::string_view text) const {
+    auto it = symbols.find(text);
+    return (it != symbols.end()) ? it->second : NO_SYMBOL;
+}
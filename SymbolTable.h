@@ -0,0 +1,69 @@
+// SymbolTable.h
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Compact identifier of an interned string
+using Symbol = std::uint32_t;
+
+// Returned by SymbolTable::find for strings that were never interned
+constexpr Symbol NO_SYMBOL = std::numeric_limits<Symbol>::max();
+
+// The `SymbolTable` class interns strings: every distinct string is stored once and identified by
+// a small integer Symbol, so objects that repeat the same few values (vehicle makes and models) can
+// hold a 4-byte Symbol instead of their own std::string, and equality becomes an integer compare.
+// Interned strings are never removed, so the references returned by text() stay valid for the
+// lifetime of the program.
+class SymbolTable {
+public:
+    /**
+     * @brief Get the program-wide symbol table
+     *
+     * @return SymbolTable& The global table
+     */
+    static SymbolTable& global();
+
+    /**
+     * @brief Intern a string, adding it if it is new
+     *
+     * @param text The string to intern
+     * @return Symbol The string's symbol
+     */
+    Symbol intern(std::string_view text);
+
+    /**
+     * @brief Look up a string without interning it
+     *
+     * @param text The string to look up
+     * @return Symbol The string's symbol, or NO_SYMBOL if it was never interned
+     */
+    Symbol find(std::string_view text) const;
+
+    /**
+     * @brief Get the text of a symbol
+     *
+     * @param symbol The symbol
+     * @return const std::string& The interned text
+     */
+    const std::string& text(Symbol symbol) const { return strings[symbol]; }
+
+    /**
+     * @brief Get the number of interned strings (symbols are 0 .. size() - 1)
+     *
+     * @return std::size_t The number of symbols
+     */
+    std::size_t size() const { return strings.size(); }
+
+private:
+    std::deque<std::string> strings;                        // Symbol -> text (deque keeps addresses stable)
+    std::unordered_map<std::string_view, Symbol> symbols;   // Text (viewing `strings`) -> symbol
+};
+
+#endif // SYMBOLTABLE_H
@@ -0,0 +1,185 @@
+// SymbolTrie.cpp
+#include "SymbolTrie.h"
+#include "LevenshteinAutomaton.h"
+#include <algorithm>
+
+namespace {
+
+bool byCharacter(const std::pair<char, std::uint32_t>& entry, char key) {
+    return entry.first < key;
+}
+
+} // namespace
+
+/**
+ * The function `insert` adds `symbol` to the trie, creating the nodes for its text that do not
+ * exist yet and counting it in the subtree of every node on the way.
+ *
+ * @param symbol The `symbol` parameter is the interned string to add.
+ */
+void SymbolTrie::insert(Symbol symbol) {
+    const std::string_view text = SymbolTable::global().text(symbol);
+    std::vector<std::uint32_t> path;
+    path.reserve(text.size() + 1);
+    path.push_back(0);
+    for (char c : text) {
+        std::uint32_t next = child(path.back(), c);
+        if (next == NONE) {
+            next = static_cast<std::uint32_t>(nodes.size());
+            auto& children = nodes[path.back()].children;
+            children.emplace(std::lower_bound(children.begin(), children.end(), c, byCharacter), c, next);
+            nodes.emplace_back();
+        }
+        path.push_back(next);
+    }
+    if (nodes[path.back()].symbol == symbol) {
+        return;
+    }
+    nodes[path.back()].symbol = symbol;
+    for (std::uint32_t node : path) {
+        ++nodes[node].live;
+    }
+}
+
+/**
+ * The function `erase` removes `symbol` from the results of future searches. Its nodes stay in the
+ * trie; the live counts on its path drop so that searches skip subtrees left without symbols.
+ *
+ * @param symbol The `symbol` parameter is the interned string to remove.
+ */
+void SymbolTrie::erase(Symbol symbol) {
+    const std::string_view text = SymbolTable::global().text(symbol);
+    std::vector<std::uint32_t> path;
+    path.reserve(text.size() + 1);
+    path.push_back(0);
+    for (char c : text) {
+        const std::uint32_t next = child(path.back(), c);
+        if (next == NONE) {
+            return;
+        }
+        path.push_back(next);
+    }
+    if (nodes[path.back()].symbol != symbol) {
+        return;
+    }
+    nodes[path.back()].symbol = NO_SYMBOL;
+    for (std::uint32_t node : path) {
+        --nodes[node].live;
+    }
+}
+
+/**
+ * The function `walk` runs a Levenshtein automaton for `text` down the trie, depth first, and calls
+ * `emit(symbol, distance)` for every live symbol it accepts. Each node's automaton state is computed
+ * from its parent's, kept in one buffer with a row per depth, and a child is only entered if it has
+ * live symbols below it and the automaton can still accept after reading its character. Accepting
+ * states at live nodes are exactly the symbols within `maxDistance` of `text`, and an accepting
+ * state's last entry is the symbol's exact distance.
+ *
+ * @param text The `text` parameter is the query string.
+ * @param maxDistance The `maxDistance` parameter is the largest edit distance to accept.
+ * @param emit The `emit` parameter receives each matching symbol and its distance.
+ *
+ * @return The number of trie nodes the automaton stepped into.
+ */
+template <typename Emit>
+std::size_t SymbolTrie::walk(std::string_view text, std::size_t maxDistance, Emit emit) const {
+    if (nodes[0].live == 0) {
+        return 0;
+    }
+    const LevenshteinAutomaton automaton(text, maxDistance);
+    const std::size_t width = automaton.stateSize();
+    std::vector<std::size_t> rows(width);
+    automaton.start(rows.data());
+    if (nodes[0].symbol != NO_SYMBOL && automaton.accepts(rows.data())) {
+        emit(nodes[0].symbol, automaton.distance(rows.data()));
+    }
+
+    // Every pending node's parent row stays intact: a depth-first walk only overwrites deeper rows
+    std::size_t stepped = 0;
+    struct Pending {
+        char c;                     // The character on the edge into the node
+        std::uint32_t node;         // The node to step into
+        std::size_t parentDepth;    // Depth of the node's parent
+    };
+    std::vector<Pending> pending;
+    for (const auto& entry : nodes[0].children) {
+        pending.push_back(Pending{ entry.first, entry.second, 0 });
+    }
+    while (!pending.empty()) {
+        const auto [c, index, parentDepth] = pending.back();
+        pending.pop_back();
+        const Node& node = nodes[index];
+        if (node.live == 0) {
+            continue;
+        }
+
+        const std::size_t depth = parentDepth + 1;
+        if (rows.size() < (depth + 1) * width) {
+            rows.resize((depth + 1) * width);
+        }
+        ++stepped;
+        if (!automaton.step(rows.data() + parentDepth * width, c, rows.data() + depth * width)) {
+            continue;
+        }
+        if (node.symbol != NO_SYMBOL && automaton.accepts(rows.data() + depth * width)) {
+            emit(node.symbol, automaton.distance(rows.data() + depth * width));
+        }
+        for (const auto& entry : node.children) {
+            pending.push_back(Pending{ entry.first, entry.second, depth });
+        }
+    }
+    return stepped;
+}
+
+/**
+ * The function `search` collects the symbols `walk` accepts for `text`: exactly the symbols within
+ * `maxDistance` of it, as comparing `text` with every symbol would find.
+ *
+ * @param text The `text` parameter is the query string.
+ * @param maxDistance The `maxDistance` parameter is the largest edit distance to accept.
+ * @param matches The `matches` parameter receives the symbols within `maxDistance` of `text`.
+ *
+ * @return The number of trie nodes the automaton stepped into, which is what the trie saves on
+ * compared with checking every distinct string.
+ */
+std::size_t SymbolTrie::search(std::string_view text, std::size_t maxDistance, std::vector<Symbol>& matches) const {
+    return walk(text, maxDistance, [&](Symbol symbol, std::size_t) { matches.push_back(symbol); });
+}
+
+/**
+ * The function `search` finds the same symbols as the other overload and also reports each one's
+ * edit distance from `text`, which the automaton's accepting state already holds. Ranked searches
+ * use it to take the closest values first.
+ *
+ * @param text The `text` parameter is the query string.
+ * @param maxDistance The `maxDistance` parameter is the largest edit distance to accept.
+ * @param matches The `matches` parameter receives (symbol, distance) pairs.
+ *
+ * @return The number of trie nodes the automaton stepped into.
+ */
+std::size_t SymbolTrie::search(std::string_view text, std::size_t maxDistance,
+                               std::vector<std::pair<Symbol, std::size_t>>& matches) const {
+    return walk(text, maxDistance, [&](Symbol symbol, std::size_t distance) { matches.emplace_back(symbol, distance); });
+}
+
+/**
+ * The function `clear` removes every symbol and node.
+ */
+void SymbolTrie::clear() {
+    nodes.assign(1, Node{});
+}
+
+/**
+ * The function `child` finds the child of `node` reached by `c`.
+ *
+ * @param node The `node` parameter is the node to look under.
+ * @param c The `c` parameter is the character on the edge.
+ *
+ * @return The child's index, or NONE if `node` has no edge for `c`.
+ */
+std::uint32_t SymbolTrie::child(std::uint32_t node, char c) const {
+    const auto& children = nodes[node].children;
+    auto it = std::lower_bound(children.begin(), children.end(), c, byCharacter);
+    return (it != children.end() && it->first == c) ? it->second : NONE;
+}
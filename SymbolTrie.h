@@ -0,0 +1,86 @@
+// SymbolTrie.h
+#ifndef SYMBOLTRIE_H
+#define SYMBOLTRIE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "SymbolTable.h"
+
+// The `SymbolTrie` class is a character trie over interned strings for fuzzy lookups. A search runs
+// a LevenshteinAutomaton for the query down the trie: strings sharing a prefix share the automaton
+// steps for it, and a subtree is abandoned as soon as the automaton reports that nothing below it can
+// be within the threshold. A fuzzy lookup therefore touches the handful of trie paths near the query
+// instead of comparing it with every distinct string.
+//
+// Every node counts the live symbols in its subtree, so subtrees whose symbols have all been erased
+// are skipped too. Erased nodes stay in the trie and are reused if the symbol comes back.
+class SymbolTrie {
+public:
+    SymbolTrie() : nodes(1) {}
+
+    /**
+     * @brief Add a symbol to the trie (no-op if it is already present)
+     *
+     * @param symbol The symbol to add
+     */
+    void insert(Symbol symbol);
+
+    /**
+     * @brief Remove a symbol from the trie (no-op if it is not present)
+     *
+     * @param symbol The symbol to remove
+     */
+    void erase(Symbol symbol);
+
+    /**
+     * @brief Find every symbol within `maxDistance` edits of `text`
+     *
+     * @param text The query string
+     * @param maxDistance The largest edit distance to accept
+     * @param matches Receives the matching symbols (appended, in no particular order)
+     * @return std::size_t The number of trie nodes the automaton stepped into
+     */
+    std::size_t search(std::string_view text, std::size_t maxDistance, std::vector<Symbol>& matches) const;
+
+    /**
+     * @brief Find every symbol within `maxDistance` edits of `text`, with its distance
+     *
+     * @param text The query string
+     * @param maxDistance The largest edit distance to accept
+     * @param matches Receives (symbol, exact distance) pairs (appended, in no particular order)
+     * @return std::size_t The number of trie nodes the automaton stepped into
+     */
+    std::size_t search(std::string_view text, std::size_t maxDistance, std::vector<std::pair<Symbol, std::size_t>>& matches) const;
+
+    /**
+     * @brief Get the number of symbols in the trie
+     *
+     * @return std::size_t The number of live symbols
+     */
+    std::size_t size() const { return nodes[0].live; }
+
+    /**
+     * @brief Remove all symbols
+     */
+    void clear();
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        std::vector<std::pair<char, std::uint32_t>> children;  // (character, node), sorted by character
+        Symbol symbol = NO_SYMBOL;                              // The symbol ending here, if it is live
+        std::uint32_t live = 0;                                 // Live symbols in the subtree
+    };
+
+    std::uint32_t child(std::uint32_t node, char c) const;
+    template <typename Emit>
+    std::size_t walk(std::string_view text, std::size_t maxDistance, Emit emit) const;
+
+    std::vector<Node> nodes; // Node 0 is the root (the empty string)
+};
+
+#endif // SYMBOLTRIE_H
@@ -0,0 +1,135 @@
+// TopK.h
+#ifndef TOPK_H
+#define TOPK_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// The `RankedResult` struct is one entry of a ranked search: the item and its score (lower is better).
+template <typename T>
+struct RankedResult {
+    std::shared_ptr<T> item;    // The matching item
+    double score;               // Ranking score, lower is better
+};
+
+// The `TopK` class keeps the `capacity` best (lowest-scoring) values pushed into it, using a
+// bounded max-heap whose top is the current worst kept value, so each push is O(log k) and memory
+// stays O(k) however many candidates are offered. Equal scores are broken by push order: the value
+// pushed first ranks higher, which keeps ranked searches deterministic.
+template <typename T>
+class TopK {
+public:
+    /**
+     * @brief Construct an empty selection
+     *
+     * @param keep The number of values to keep
+     */
+    explicit TopK(std::size_t keep) : capacity(keep) {
+        heap.reserve(keep);
+    }
+
+    /**
+     * @brief Check whether `capacity` values are held
+     *
+     * @return bool True if the selection is full
+     */
+    bool full() const {
+        return heap.size() >= capacity;
+    }
+
+    /**
+     * @brief Check whether a value with `score`, pushed now, would be kept
+     *
+     * Once this returns false for the smallest score any remaining candidate could have, the search
+     * can stop.
+     *
+     * @param score The candidate score
+     * @return bool True if the value would enter the selection
+     */
+    bool wouldAccept(double score) const {
+        return !full() || (capacity > 0 && score < heap.front().score);
+    }
+
+    /**
+     * @brief Offer a value
+     *
+     * @param score The value's score (lower is better)
+     * @param value The value
+     */
+    void push(double score, T value) {
+        if (!wouldAccept(score)) {
+            return;
+        }
+        if (full()) {
+            std::pop_heap(heap.begin(), heap.end(), ranksBefore);
+            heap.pop_back();
+        }
+        heap.push_back(Entry{ score, nextSequence++, std::move(value) });
+        std::push_heap(heap.begin(), heap.end(), ranksBefore);
+    }
+
+    /**
+     * @brief Take the kept values, best first
+     *
+     * @return std::vector<std::pair<double, T>> (score, value) pairs in ascending score order
+     */
+    std::vector<std::pair<double, T>> takeSorted() {
+        std::sort_heap(heap.begin(), heap.end(), ranksBefore);
+        std::vector<std::pair<double, T>> sorted;
+        sorted.reserve(heap.size());
+        for (auto& entry : heap) {
+            sorted.emplace_back(entry.score, std::move(entry.value));
+        }
+        heap.clear();
+        return sorted;
+    }
+
+private:
+    struct Entry {
+        double score;
+        std::size_t sequence;   // Push order, for tie-breaking
+        T value;
+    };
+
+    // True if `a` ranks ahead of `b`; as the heap order it puts the last-ranked entry on top
+    static bool ranksBefore(const Entry& a, const Entry& b) {
+        return a.score != b.score ? a.score < b.score : a.sequence < b.sequence;
+    }
+
+    std::size_t capacity;           // Number of values to keep
+    std::size_t nextSequence = 0;   // Sequence number for the next push
+    std::vector<Entry> heap;        // Max-heap on (score, sequence)
+};
+
+/**
+ * @brief Pick the best `limit` candidates whose scores are an integer bucket plus a fraction
+ *
+ * Candidate `c` in `buckets[d]` scores `d + fraction(c)` with `fraction(c)` in [0, 1), so every
+ * candidate in a later bucket scores at least that bucket's index. Buckets are visited in order and
+ * the walk stops as soon as the heap is full and its worst score beats the next bucket's floor.
+ *
+ * @tparam Fraction Callable taking a candidate and returning a double in [0, 1)
+ * @param buckets Candidates grouped by the integer part of their score
+ * @param limit The number of candidates to keep
+ * @param fraction The fractional part of a candidate's score
+ * @return std::vector<std::pair<double, std::size_t>> (score, candidate) pairs, best first
+ */
+template <typename Fraction>
+std::vector<std::pair<double, std::size_t>> rankBuckets(const std::vector<std::vector<std::size_t>>& buckets,
+                                                        std::size_t limit, Fraction fraction) {
+    TopK<std::size_t> best(limit);
+    for (std::size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+        if (!best.wouldAccept(static_cast<double>(bucket))) {
+            break;
+        }
+        for (std::size_t candidate : buckets[bucket]) {
+            best.push(static_cast<double>(bucket) + fraction(candidate), candidate);
+        }
+    }
+    return best.takeSorted();
+}
+
+#endif // TOPK_H
\ No newline at end of file
@@ -0,0 +1,212 @@
+// TrigramIndex.h
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// The `TrigramIndex` class is an inverted index from character trigrams to the items whose text
+// contains them, used to find fuzzy-search candidates without comparing the query against every
+// item. Text is padded with two sentinels on each side, so a string of length n has n + 2 trigrams
+// and even one- and two-character strings are indexed.
+//
+// A single edit changes at most three trigrams, so any text within edit distance k of a query of
+// length m shares at least (m + 2) - 3k trigrams with it (counted as a multiset) and differs from it
+// in length by at most k. search() returns only the items passing both filters, which callers must
+// then verify with an exact distance. When (m + 2) - 3k <= 0 the filter cannot exclude anything and
+// search() reports that instead, so the caller falls back to a scan.
+//
+// Items are returned in the order they were inserted.
+template <typename T>
+class TrigramIndex {
+public:
+    /**
+     * @brief Index an item under `text` (no-op if the item is already indexed)
+     *
+     * @param item The item to index
+     * @param text The text to index it under
+     */
+    void insert(const std::shared_ptr<T>& item, std::string_view text) {
+        if (docOf.count(item.get()) != 0) {
+            return;
+        }
+        std::uint32_t doc;
+        if (!freeDocs.empty()) {
+            doc = freeDocs.back();
+            freeDocs.pop_back();
+        } else {
+            doc = static_cast<std::uint32_t>(docs.size());
+            docs.emplace_back();
+        }
+
+        Doc& entry = docs[doc];
+        entry.item = item;
+        entry.order = nextOrder++;
+        entry.length = text.size();
+        entry.grams = countTrigrams(text);
+        for (const auto& gram : entry.grams) {
+            postings[gram.first].emplace_back(doc, gram.second);
+        }
+        docOf.emplace(item.get(), doc);
+    }
+
+    /**
+     * @brief Remove an item from the index (no-op if it is not indexed)
+     *
+     * @param item The item to remove
+     */
+    void erase(const std::shared_ptr<T>& item) {
+        auto it = docOf.find(item.get());
+        if (it == docOf.end()) {
+            return;
+        }
+        const std::uint32_t doc = it->second;
+        docOf.erase(it);
+
+        Doc& entry = docs[doc];
+        for (const auto& gram : entry.grams) {
+            auto posting = postings.find(gram.first);
+            auto& entries = posting->second;
+            for (std::size_t i = 0; i < entries.size(); ++i) {
+                if (entries[i].first == doc) {
+                    entries[i] = entries.back();
+                    entries.pop_back();
+                    break;
+                }
+            }
+            if (entries.empty()) {
+                postings.erase(posting);
+            }
+        }
+        entry = Doc{};
+        freeDocs.push_back(doc);
+    }
+
+    /**
+     * @brief Find the items that may be within `maxDistance` edits of `query`
+     *
+     * @param query The query text
+     * @param maxDistance The largest edit distance of interest
+     * @param candidates Receives the candidate items in insertion order (must be verified by the caller)
+     * @return bool False if the trigram filter cannot narrow this query (candidates is left untouched)
+     */
+    bool search(std::string_view query, std::size_t maxDistance, std::vector<std::shared_ptr<T>>& candidates) const {
+        return collect(query, maxDistance, [&](std::size_t count) { candidates.reserve(candidates.size() + count); },
+                       [&](const Doc& doc) { candidates.push_back(doc.item); });
+    }
+
+    /**
+     * @brief Find the items that may be within `maxDistance` edits of `query`, without sharing ownership
+     *
+     * @param query The query text
+     * @param maxDistance The largest edit distance of interest
+     * @param candidates Receives pointers to the candidate items in insertion order (must be verified by the caller)
+     * @return bool False if the trigram filter cannot narrow this query (candidates is left untouched)
+     */
+    bool search(std::string_view query, std::size_t maxDistance, std::vector<const T*>& candidates) const {
+        return collect(query, maxDistance, [&](std::size_t count) { candidates.reserve(candidates.size() + count); },
+                       [&](const Doc& doc) { candidates.push_back(doc.item.get()); });
+    }
+
+    /**
+     * @brief Remove all items
+     */
+    void clear() {
+        docs.clear();
+        freeDocs.clear();
+        docOf.clear();
+        postings.clear();
+        nextOrder = 0;
+    }
+
+private:
+    using Trigram = std::uint32_t;
+    using GramCounts = std::vector<std::pair<Trigram, std::uint32_t>>; // (trigram, occurrences)
+
+    struct Doc {
+        std::shared_ptr<T> item;
+        std::uint64_t order = 0;    // Insertion sequence number
+        std::size_t length = 0;     // Length of the indexed text
+        GramCounts grams;           // Distinct trigrams of the text, with multiplicity
+    };
+
+    static constexpr unsigned char PAD = 0;
+
+    static GramCounts countTrigrams(std::string_view text) {
+        std::vector<Trigram> grams;
+        grams.reserve(text.size() + 2);
+        auto at = [&](std::size_t i) -> Trigram {
+            // Position i of the padded text: two sentinels, the text, two sentinels
+            return (i < 2 || i - 2 >= text.size()) ? PAD : static_cast<unsigned char>(text[i - 2]);
+        };
+        for (std::size_t i = 0; i < text.size() + 2; ++i) {
+            grams.push_back((at(i) << 16) | (at(i + 1) << 8) | at(i + 2));
+        }
+        std::sort(grams.begin(), grams.end());
+
+        GramCounts counts;
+        for (Trigram gram : grams) {
+            if (!counts.empty() && counts.back().first == gram) {
+                ++counts.back().second;
+            } else {
+                counts.emplace_back(gram, 1);
+            }
+        }
+        return counts;
+    }
+
+    // Runs the count and length filters and emits the surviving docs in insertion order
+    template <typename Reserve, typename Emit>
+    bool collect(std::string_view query, std::size_t maxDistance, Reserve reserve, Emit emit) const {
+        const std::size_t gramCount = query.size() + 2;
+        if (gramCount <= 3 * maxDistance) {
+            return false;
+        }
+        const std::size_t required = gramCount - 3 * maxDistance;
+
+        // Count the trigrams each item shares with the query, touching only the relevant postings
+        std::vector<std::uint32_t> shared(docs.size(), 0);
+        std::vector<std::uint32_t> touched;
+        for (const auto& gram : countTrigrams(query)) {
+            auto posting = postings.find(gram.first);
+            if (posting == postings.end()) {
+                continue;
+            }
+            for (const auto& entry : posting->second) {
+                if (shared[entry.first] == 0) {
+                    touched.push_back(entry.first);
+                }
+                shared[entry.first] += std::min(gram.second, entry.second);
+            }
+        }
+
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> hits; // (insertion order, doc)
+        for (std::uint32_t doc : touched) {
+            const std::size_t length = docs[doc].length;
+            const std::size_t lengthGap = length > query.size() ? length - query.size() : query.size() - length;
+            if (shared[doc] >= required && lengthGap <= maxDistance) {
+                hits.emplace_back(docs[doc].order, doc);
+            }
+        }
+        std::sort(hits.begin(), hits.end());
+        reserve(hits.size());
+        for (const auto& hit : hits) {
+            emit(docs[hit.second]);
+        }
+        return true;
+    }
+
+    std::vector<Doc> docs;                                                              // Doc id -> indexed item
+    std::vector<std::uint32_t> freeDocs;                                                // Doc ids free for re-use
+    std::unordered_map<const T*, std::uint32_t> docOf;                                  // Item -> doc id
+    std::unordered_map<Trigram, std::vector<std::pair<std::uint32_t, std::uint32_t>>> postings; // Trigram -> (doc id, occurrences)
+    std::uint64_t nextOrder = 0;                                                        // Next insertion sequence number
+};
+
+#endif // TRIGRAMINDEX_H
@@ -5,6 +5,10 @@
 #include <string>
 #include <regex>
 #include <iostream>
+#include <array>
+#include <utility>
+#include <iterator>
+#include <cstdint>
 
 /**
  * The function calculates the Levenshtein distance between two input strings using dynamic
@@ -39,6 +43,141 @@ size_t levenshteinDistance(const std::string& s1, const std::string& s2) {
     return dp[m][n];
 }
 
+namespace {
+
+/**
+ * Bit-parallel (Myers/Hyyrö) Levenshtein distance for a pattern of at most 64 characters. Each bit
+ * of the vertical delta vectors Pv/Mv holds the +1/-1 difference between adjacent rows of one DP
+ * column, so a whole column is updated with a handful of word operations per text character. The
+ * per-character match masks live in a thread-local table that is cleared again before returning,
+ * so no per-call memset or allocation is needed.
+ */
+size_t bitParallelDistance(std::string_view pattern, std::string_view text, size_t maxDistance) {
+    thread_local std::array<std::uint64_t, 256> peq{};
+
+    const size_t m = pattern.size();
+    const size_t n = text.size();
+    for (size_t i = 0; i < m; ++i) {
+        peq[static_cast<unsigned char>(pattern[i])] |= std::uint64_t{ 1 } << i;
+    }
+
+    const std::uint64_t last = std::uint64_t{ 1 } << (m - 1);
+    std::uint64_t pv = ~std::uint64_t{ 0 };
+    std::uint64_t mv = 0;
+    size_t score = m;
+
+    for (size_t j = 0; j < n; ++j) {
+        const std::uint64_t eq = peq[static_cast<unsigned char>(text[j])];
+        const std::uint64_t xv = eq | mv;
+        const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+
+        if (ph & last) {
+            ++score;
+        } else if (mh & last) {
+            --score;
+        }
+
+        // Each remaining column can lower the score by at most one
+        if (score > maxDistance + (n - j - 1)) {
+            score = maxDistance + 1;
+            break;
+        }
+
+        ph = (ph << 1) | 1; // Row 0 grows by one per column (D[0][j] = j)
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+
+    for (size_t i = 0; i < m; ++i) {
+        peq[static_cast<unsigned char>(pattern[i])] = 0;
+    }
+    return score > maxDistance ? maxDistance + 1 : score;
+}
+
+/**
+ * Banded two-row dynamic programme for pairs too long for the bit-parallel kernel. Only cells
+ * within `maxDistance` of the diagonal can hold a value within the threshold, so only those are
+ * computed, and the search stops as soon as a whole band row exceeds the threshold. The row
+ * buffers are thread-local and reused between calls.
+ */
+size_t bandedDistance(std::string_view s1, std::string_view s2, size_t maxDistance) {
+    thread_local std::vector<size_t> previous;
+    thread_local std::vector<size_t> current;
+
+    const size_t m = s1.size();
+    const size_t n = s2.size();
+    const size_t over = maxDistance + 1;
+    if (previous.size() < n + 1) {
+        previous.resize(n + 1);
+        current.resize(n + 1);
+    }
+
+    for (size_t j = 0; j <= n; ++j) {
+        previous[j] = j <= maxDistance ? j : over;
+    }
+
+    for (size_t i = 1; i <= m; ++i) {
+        const size_t from = i > maxDistance ? i - maxDistance : 1;
+        const size_t to = std::min(n, i + maxDistance);
+        current[from - 1] = (from == 1 && i <= maxDistance) ? i : over;
+
+        size_t rowMin = current[from - 1];
+        for (size_t j = from; j <= to; ++j) {
+            const size_t cost = (s1[i - 1] == s2[j - 1]) ? 0 : 1;
+            size_t best = previous[j - 1] + cost;
+            best = std::min(best, previous[j] + 1);
+            best = std::min(best, current[j - 1] + 1);
+            current[j] = std::min(best, over);
+            rowMin = std::min(rowMin, current[j]);
+        }
+        if (to < n) {
+            current[to + 1] = over; // Right edge of the band for the next row
+        }
+        if (rowMin > maxDistance) {
+            return over;
+        }
+        std::swap(previous, current);
+    }
+    return std::min(previous[n], over);
+}
+
+} // namespace
+
+/**
+ * The function `boundedLevenshteinDistance` answers "is the edit distance at most `maxDistance`,
+ * and if so what is it", which is all the searches need, without the full DP matrix of
+ * `levenshteinDistance`. A length difference larger than the threshold is rejected immediately;
+ * otherwise the shorter string is used as the bit-parallel pattern when it fits in 64 bits, and
+ * longer pairs fall back to a banded DP.
+ *
+ * @param s1 The first string to compare.
+ * @param s2 The second string to compare.
+ * @param maxDistance The `maxDistance` parameter is the search threshold.
+ *
+ * @return The Levenshtein distance between `s1` and `s2` if it is at most `maxDistance`, otherwise
+ * `maxDistance + 1`.
+ */
+size_t boundedLevenshteinDistance(std::string_view s1, std::string_view s2, size_t maxDistance) {
+    if (s1.size() > s2.size()) {
+        std::swap(s1, s2);
+    }
+    // The distance is at least the length difference and at most the longer length
+    if (s2.size() - s1.size() > maxDistance) {
+        return maxDistance + 1;
+    }
+    maxDistance = std::min(maxDistance, s2.size());
+    if (s1.empty()) {
+        return s2.size();
+    }
+    if (s1.size() <= 64) {
+        return bitParallelDistance(s1, s2, maxDistance);
+    }
+    return bandedDistance(s1, s2, maxDistance);
+}
+
 /**
  * The isValidName function checks if a given string only contains alphabetic characters and spaces.
  *
@@ -84,7 +223,7 @@ bool isValidVehicleID(const std::string& id) {
  * `false` otherwise.
  */
 bool isValidCustomerID(int id) {
-    return id >= 100 && id <= 999;
+    return id >= MIN_CUSTOMER_ID && id <= MAX_CUSTOMER_ID;
 }
 
 /**
@@ -134,3 +273,52 @@ std::string trimWhitespace(const std::string& str) {
 bool isValidModelName(const std::string &model) {
   return !model.empty() && model.length() <= 50;
 }
+
+/**
+ * The function `sortVehiclesByID` orders vehicles by ID with an LSD radix sort over their packed
+ * `VehicleKey`s, so no ID strings are compared. Byte positions on which every key agrees are
+ * skipped, which for typical fleets leaves only two or three counting passes.
+ *
+ * @param vehicles The `vehicles` parameter is the vector of vehicles to sort in place. Vehicles whose
+ * IDs cannot be packed are moved after the others and ordered by their text.
+ */
+void sortVehiclesByID(std::vector<std::shared_ptr<Vehicle>>& vehicles) {
+    // Unpackable IDs go to the tail and are sorted by text
+    auto packedEnd = std::stable_partition(vehicles.begin(), vehicles.end(), [](const std::shared_ptr<Vehicle>& vehicle) {
+        return vehicle->getVehicleKey() != NO_VEHICLE_KEY;
+    });
+    std::sort(packedEnd, vehicles.end(), [](const std::shared_ptr<Vehicle>& a, const std::shared_ptr<Vehicle>& b) {
+        return a->getVehicleID() < b->getVehicleID();
+    });
+
+    const std::size_t count = static_cast<std::size_t>(packedEnd - vehicles.begin());
+    std::vector<std::pair<VehicleKey, std::size_t>> keys(count), buffer(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        keys[i] = { vehicles[i]->getVehicleKey(), i };
+    }
+
+    for (unsigned shift = 0; shift < 64; shift += 8) {
+        std::array<std::size_t, 257> offsets{};
+        for (const auto& entry : keys) {
+            ++offsets[((entry.first >> shift) & 0xFF) + 1];
+        }
+        if (std::find(offsets.begin() + 1, offsets.end(), count) != offsets.end()) {
+            continue; // Every key has the same byte here
+        }
+        for (std::size_t b = 1; b < offsets.size(); ++b) {
+            offsets[b] += offsets[b - 1];
+        }
+        for (const auto& entry : keys) {
+            buffer[offsets[(entry.first >> shift) & 0xFF]++] = entry;
+        }
+        keys.swap(buffer);
+    }
+
+    std::vector<std::shared_ptr<Vehicle>> sorted;
+    sorted.reserve(vehicles.size());
+    for (const auto& entry : keys) {
+        sorted.push_back(std::move(vehicles[entry.second]));
+    }
+    std::move(packedEnd, vehicles.end(), std::back_inserter(sorted));
+    vehicles.swap(sorted);
+}
@@ -5,10 +5,14 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <iterator>
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <string_view>
 #include "Repository.h"
+#include "SearchCursor.h"
+#include "WorkerPool.h"
 
 // Validation functions
 
@@ -72,6 +76,20 @@ inline void printHeader(const std::vector<std::string>& headers, const std::vect
  */
 size_t levenshteinDistance(const std::string& s1, const std::string& s2);
 
+/**
+ * @brief Calculate the Levenshtein distance between two strings, up to a threshold
+ *
+ * Gives the same answer as levenshteinDistance whenever the distance is within `maxDistance`, but
+ * stops as soon as the threshold is known to be exceeded and never allocates on the heap. Strings
+ * of up to 64 characters use a bit-parallel kernel; longer pairs use a banded dynamic programme.
+ *
+ * @param s1 The first string
+ * @param s2 The second string
+ * @param maxDistance The largest distance of interest
+ * @return size_t The distance if it is at most maxDistance, otherwise maxDistance + 1
+ */
+size_t boundedLevenshteinDistance(std::string_view s1, std::string_view s2, size_t maxDistance);
+
 // Helper function to truncate strings
 
 /**
@@ -91,6 +109,27 @@ inline std::string truncateString(const std::string& str, size_t maxWidth) {
 
 // Template function to display items in a table format with dynamic sizing and overflow handling
 
+/**
+ * @brief Print one item as a table row
+ *
+ * @tparam T The type of the item
+ * @param item The item to print
+ * @param widths The widths of the columns
+ */
+template <typename T>
+void printItemRow(const T& item, const std::vector<int>& widths) {
+    const auto row = item.toRow();
+    std::cout << "|";
+    for (size_t i = 0; i < row.size(); ++i) {
+        if (i == 7 || i == 8) { // Assuming rental rate and late fee are at index 7 and 8
+            std::cout << " " << std::left << std::setw(widths[i]) << std::fixed << std::setprecision(2) << std::stod(row[i]) << " |";
+        } else {
+            std::cout << " " << std::left << std::setw(widths[i]) << truncateString(row[i], static_cast<size_t>(widths[i])) << " |";
+        }
+    }
+    std::cout << std::endl;
+}
+
 /**
  * @brief Display items in a table format with dynamic sizing and overflow handling
  *
@@ -110,17 +149,27 @@ void displayItems(const std::vector<std::shared_ptr<T>>& items, const std::vecto
 
     // Print items
     for (const auto& item : items) {
-        const auto row = item->toRow();
-        std::cout << "|";
-        for (size_t i = 0; i < row.size(); ++i) {
-            if (i == 7 || i == 8) { // Assuming rental rate and late fee are at index 7 and 8
-                std::cout << " " << std::left << std::setw(widths[i]) << std::fixed << std::setprecision(2) << std::stod(row[i]) << " |";
-            } else {
-                std::cout << " " << std::left << std::setw(widths[i]) << truncateString(row[i], static_cast<size_t>(widths[i])) << " |";
-            }
-        }
-        std::cout << std::endl;
+        printItemRow(*item, widths);
+    }
+    printSeparator(widths);
+}
+
+/**
+ * @brief Display the remaining matches of a search cursor in a table format, streaming rows as they are found
+ *
+ * @tparam T The type of the items
+ * @param items The cursor to drain
+ * @param headers The headers of the table
+ * @param widths The widths of the columns
+ */
+template <typename T>
+void displayItems(SearchCursor<T>& items, const std::vector<std::string>& headers, const std::vector<int>& widths) {
+    if (headers.size() != widths.size()) {
+        throw std::runtime_error("Headers and widths size mismatch.");
     }
+
+    printHeader(headers, widths);
+    items.forEach([&](const T& item) { printItemRow(item, widths); });
     printSeparator(widths);
 }
 
@@ -183,11 +232,27 @@ void sortItems(std::vector<std::shared_ptr<T>>& items, Compare comp) {
     std::sort(items.begin(), items.end(), comp);
 }
 
+// Sorting vehicles by ID
+
+/**
+ * @brief Sort vehicles by ID using a radix sort on their packed keys
+ *
+ * Packed IDs ("V<digits>") are ordered by numeric value; IDs that cannot be packed follow them in
+ * text order.
+ *
+ * @param vehicles The vehicles to sort
+ */
+void sortVehiclesByID(std::vector<std::shared_ptr<Vehicle>>& vehicles);
+
 // Template for searching items by criteria
 
 /**
  * @brief Search for items by criteria
  *
+ * Repositories of at least parallelScanThreshold() items are split into contiguous chunks scanned
+ * on the worker pool, so `criteria` must be safe to call concurrently. Each chunk keeps its own
+ * matches and the chunks are joined in order, so the result is the same as a sequential scan.
+ *
  * @tparam T The type of the items
  * @tparam Criteria The criteria function
  * @param repository The repository to search in
@@ -196,15 +261,54 @@ void sortItems(std::vector<std::shared_ptr<T>>& items, Compare comp) {
  */
 template <typename T, typename Criteria>
 std::vector<std::shared_ptr<T>> searchItems(const Repository<T>& repository, Criteria criteria) {
+    const auto& items = repository.getAll();
+    const std::size_t chunks = scanChunkCount(items.size());
     std::vector<std::shared_ptr<T>> results;
-    for (const auto& item : repository.getAll()) {
-        if (criteria(item)) {
-            results.push_back(item);
+    if (chunks == 1) {
+        for (const auto& item : items) {
+            if (criteria(item)) {
+                results.push_back(item);
+            }
+        }
+        return results;
+    }
+
+    std::vector<std::vector<std::shared_ptr<T>>> partial(chunks);
+    forEachChunk(items.size(), chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (criteria(items[i])) {
+                partial[chunk].push_back(items[i]);
+            }
         }
+    });
+
+    std::size_t total = 0;
+    for (const auto& part : partial) {
+        total += part.size();
+    }
+    results.reserve(total);
+    for (auto& part : partial) {
+        std::move(part.begin(), part.end(), std::back_inserter(results));
     }
     return results;
 }
 
+/**
+ * @brief Search for items by criteria lazily
+ *
+ * Unlike searchItems nothing is copied: the criteria are checked only as the cursor is read.
+ *
+ * @tparam T The type of the items
+ * @tparam Criteria The criteria function, taking a const T&
+ * @param repository The repository to search in
+ * @param criteria The criteria function to use for searching
+ * @return SearchCursor<T> A cursor over the items matching the criteria
+ */
+template <typename T, typename Criteria>
+SearchCursor<T> findItems(const Repository<T>& repository, Criteria criteria) {
+    return SearchCursor<T>(repository.getAll(), [criteria](std::size_t, const T& item) { return criteria(item); });
+}
+
 // Function definitions
 
 /**
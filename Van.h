@@ -46,9 +46,9 @@ public:
     /**
      * @brief Get the type of the vehicle
      *
-     * @return std::string The type of the vehicle (Van)
+     * @return VehicleType The type of the vehicle (VehicleType::Van)
      */
-    std::string getType() const override { return "Van"; }
+    VehicleType getType() const override { return VehicleType::Van; }
 };
 
 #endif // VAN_H
\ No newline at end of file
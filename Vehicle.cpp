@@ -24,7 +24,8 @@
  */
 Vehicle::Vehicle(const std::string& id, const std::string& mk, const std::string& mdl,
                  int passengers, int storage, bool avail)
-    : vehicleID(id), make(mk), model(mdl), passengers(passengers), capacity(storage), availability(avail), lateFee(0.0) {}
+    : vehicleID(id), key(packVehicleID(id)), make(SymbolTable::global().intern(mk)), model(SymbolTable::global().intern(mdl)),
+      passengers(passengers), capacity(storage), availability(avail), lateFee(0.0) {}
 
 
 // Getters
@@ -32,23 +33,60 @@ Vehicle::Vehicle(const std::string& id, const std::string& mk, const std::string
 /**
  * This function returns the vehicle ID of a Vehicle object.
  *
- * @return The `vehicleID` of the `Vehicle` object is being returned.
+ * @return The `vehicleID` of the `Vehicle` object is being returned by reference, without copying.
  */
-std::string Vehicle::getVehicleID() const { return vehicleID; }
+const std::string& Vehicle::getVehicleID() const { return vehicleID; }
+
+/**
+ * This function returns the vehicle ID packed into an integer key, parsed once in the constructor.
+ *
+ * @return The `key` member variable of the `Vehicle` class, or `NO_VEHICLE_KEY` if the ID is not
+ * of the form "V<digits>".
+ */
+VehicleKey Vehicle::getVehicleKey() const { return key; }
+
+/**
+ * The function `hasSameID` compares the IDs of two vehicles, as an integer compare when both IDs
+ * are packed and by text otherwise.
+ *
+ * @param other The `other` parameter is the vehicle to compare against.
+ *
+ * @return `true` if both vehicles have the same ID, `false` otherwise.
+ */
+bool Vehicle::hasSameID(const Vehicle& other) const {
+    if (key != NO_VEHICLE_KEY || other.key != NO_VEHICLE_KEY) {
+        return key == other.key;
+    }
+    return vehicleID == other.vehicleID;
+}
 
 /**
  * This function returns the make of the vehicle.
  *
- * @return The `make` member variable of the `Vehicle` class is being returned as a `std::string`.
+ * @return The interned text of the `make` symbol, returned by reference without copying.
  */
-std::string Vehicle::getMake() const { return make; }
+const std::string& Vehicle::getMake() const { return SymbolTable::global().text(make); }
 
 /**
  * This function returns the model of the vehicle.
  *
- * @return The `model` member variable of the `Vehicle` class is being returned as a `std::string`.
+ * @return The interned text of the `model` symbol, returned by reference without copying.
  */
-std::string Vehicle::getModel() const { return model; }
+const std::string& Vehicle::getModel() const { return SymbolTable::global().text(model); }
+
+/**
+ * This function returns the interned symbol of the vehicle's make.
+ *
+ * @return The `make` member variable of the `Vehicle` class, a `Symbol` in `SymbolTable::global()`.
+ */
+Symbol Vehicle::getMakeSymbol() const { return make; }
+
+/**
+ * This function returns the interned symbol of the vehicle's model.
+ *
+ * @return The `model` member variable of the `Vehicle` class, a `Symbol` in `SymbolTable::global()`.
+ */
+Symbol Vehicle::getModelSymbol() const { return model; }
 
 /**
  * This function returns the number of passengers the vehicle can carry.
@@ -96,3 +134,41 @@ void Vehicle::setAvailability(bool avail) { availability = avail; }
  * vehicle.
  */
 void Vehicle::setLateFee(double fee) { lateFee = fee; }
+
+
+// Vehicle types
+
+/**
+ * The function `vehicleTypeFromString` maps a vehicle type name, as returned by
+ * `vehicleTypeToString` (and `getTypeName`) and as written in the vehicles file, to its
+ * `VehicleType` tag.
+ *
+ * @param type The `type` parameter is the type name, e.g. "Car" or "Minibus". The match is exact.
+ *
+ * @return The matching `VehicleType`, or `VehicleType::Unknown` if the name is not recognised.
+ */
+VehicleType vehicleTypeFromString(std::string_view type) {
+    if (type == "Car") return VehicleType::Car;
+    if (type == "Van") return VehicleType::Van;
+    if (type == "Minibus") return VehicleType::Minibus;
+    if (type == "SUV") return VehicleType::SUV;
+    return VehicleType::Unknown;
+}
+
+/**
+ * The function `vehicleTypeToString` returns the display name of a `VehicleType` tag.
+ *
+ * @param type The `type` parameter is the tag to convert.
+ *
+ * @return The type name ("Car", "Van", "Minibus", "SUV"), or "Unknown", as a view of a string
+ * literal so no memory is allocated.
+ */
+std::string_view vehicleTypeToString(VehicleType type) {
+    switch (type) {
+        case VehicleType::Car: return "Car";
+        case VehicleType::Van: return "Van";
+        case VehicleType::Minibus: return "Minibus";
+        case VehicleType::SUV: return "SUV";
+        default: return "Unknown";
+    }
+}
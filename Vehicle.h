@@ -6,13 +6,47 @@
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include <cstdint>
+#include <string_view>
+#include "SymbolTable.h"
+#include "VehicleKey.h"
+
+// The `VehicleType` enum identifies the concrete vehicle class. It is what Vehicle::getType()
+// returns, so type checks are integer compares; vehicleTypeToString() gives the display name.
+enum class VehicleType : std::uint8_t {
+    Car,
+    Van,
+    Minibus,
+    SUV,
+    Unknown
+};
+
+// Number of VehicleType values, for tables indexed by type
+constexpr std::size_t VEHICLE_TYPE_COUNT = static_cast<std::size_t>(VehicleType::Unknown) + 1;
+
+/**
+ * @brief Convert a vehicle type name ("Car", "Van", "Minibus", "SUV") to its tag
+ *
+ * @param type The vehicle type name
+ * @return VehicleType The matching tag, or VehicleType::Unknown
+ */
+VehicleType vehicleTypeFromString(std::string_view type);
+
+/**
+ * @brief Get the display name of a vehicle type tag
+ *
+ * @param type The vehicle type tag
+ * @return std::string_view The type name, e.g. "Minibus" (a string literal, no allocation)
+ */
+std::string_view vehicleTypeToString(VehicleType type);
 
 // The `Vehicle` class defines a blueprint for a vehicle object.
 class Vehicle {
 protected:
     std::string vehicleID;    // Unique identifier for the vehicle
-    std::string make;         // Make of the vehicle
-    std::string model;        // Model of the vehicle
+    VehicleKey key;           // vehicleID packed into an integer (NO_VEHICLE_KEY if not packable)
+    Symbol make;              // Make of the vehicle (interned in SymbolTable::global())
+    Symbol model;             // Model of the vehicle (interned in SymbolTable::global())
     int passengers;           // Number of passengers the vehicle can carry
     int capacity;             // Storage capacity of the vehicle
     bool availability;        // Availability status of the vehicle
@@ -45,8 +79,8 @@ public:
     virtual std::vector<std::string> toRow() const {
         return {
             vehicleID,
-            make,
-            model,
+            getMake(),
+            getModel(),
             std::to_string(passengers),
             std::to_string(capacity),
             availability ? "Yes" : "No",
@@ -65,32 +99,68 @@ public:
     /**
      * @brief Get the type of the vehicle
      *
-     * @return std::string The type of the vehicle
+     * @return VehicleType The type of the vehicle
+     */
+    virtual VehicleType getType() const = 0;
+
+    /**
+     * @brief Get the display name of the vehicle's type
+     *
+     * @return std::string_view The type name, e.g. "Car"
      */
-    virtual std::string getType() const = 0;
+    std::string_view getTypeName() const { return vehicleTypeToString(getType()); }
 
     // Getters
 
     /**
      * @brief Get the vehicle ID
      *
-     * @return std::string The vehicle ID
+     * @return const std::string& The vehicle ID
+     */
+    const std::string& getVehicleID() const;
+
+    /**
+     * @brief Get the vehicle ID packed into an integer key
+     *
+     * @return VehicleKey The packed ID, or NO_VEHICLE_KEY if the ID is not of the form "V<digits>"
+     */
+    VehicleKey getVehicleKey() const;
+
+    /**
+     * @brief Check whether another vehicle has the same ID
+     *
+     * @param other The vehicle to compare with
+     * @return bool True if the IDs are equal
      */
-    std::string getVehicleID() const;
+    bool hasSameID(const Vehicle& other) const;
 
     /**
      * @brief Get the make of the vehicle
      *
-     * @return std::string The make of the vehicle
+     * @return const std::string& The make of the vehicle (the interned text, not a copy)
      */
-    std::string getMake() const;
+    const std::string& getMake() const;
 
     /**
      * @brief Get the model of the vehicle
      *
-     * @return std::string The model of the vehicle
+     * @return const std::string& The model of the vehicle (the interned text, not a copy)
+     */
+    const std::string& getModel() const;
+
+    /**
+     * @brief Get the interned symbol of the vehicle's make
+     *
+     * @return Symbol The make symbol
+     */
+    Symbol getMakeSymbol() const;
+
+    /**
+     * @brief Get the interned symbol of the vehicle's model
+     *
+     * @return Symbol The model symbol
      */
-    std::string getModel() const;
+    Symbol getModelSymbol() const;
 
     /**
      * @brief Get the number of passengers the vehicle can carry
@@ -0,0 +1,206 @@
+// VehicleColumns.h
+#ifndef VEHICLECOLUMNS_H
+#define VEHICLECOLUMNS_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "Bitmap.h"
+#include "PrefixIndex.h"
+#include "RangeIndex.h"
+#include "SymbolIndex.h"
+#include "Vehicle.h"
+
+// The `VehicleColumns` struct holds the scalar attributes of every vehicle in a Repository<Vehicle>
+// as parallel contiguous arrays (struct-of-arrays). Row `i` of every column describes the vehicle at
+// position `i` of the repository, so integer and boolean filters can run as linear passes over a
+// single array instead of dereferencing each Vehicle. The Vehicle objects remain the source of
+// truth for behaviour; the repository keeps the columns in step on every add, move and removal.
+//
+// Availability is kept as a bitmap together with live per-type available/rented counters, so
+// "how many vans are free" is a table lookup and "which vehicles are free" walks only set bits.
+// The make and model columns also have fuzzy indexes (see SymbolIndex) for edit-distance search,
+// and the passenger and storage columns have sorted indexes (see RangeIndex) for range queries.
+// Make and model texts are also counted in prefix tries (see PrefixIndex) for autocomplete.
+struct VehicleColumns {
+    std::vector<int> passengers;            // Passenger capacity
+    std::vector<int> capacity;              // Storage capacity
+    Bitmap available;                       // Availability status, one bit per vehicle
+    std::vector<VehicleType> type;          // Concrete vehicle type
+    std::vector<double> lateFee;            // Late fee per day
+    std::vector<Symbol> make;               // Interned make
+    std::vector<Symbol> model;              // Interned model
+    SymbolIndex makeIndex;                  // Fuzzy index over `make`
+    SymbolIndex modelIndex;                 // Fuzzy index over `model`
+    RangeIndex passengersIndex;             // Sorted index over `passengers`
+    RangeIndex capacityIndex;               // Sorted index over `capacity`
+    PrefixIndex makePrefixes;               // Autocomplete over make texts
+    PrefixIndex modelPrefixes;              // Autocomplete over model texts
+
+    std::array<std::size_t, VEHICLE_TYPE_COUNT> availableByType{};  // Available vehicles per type
+    std::array<std::size_t, VEHICLE_TYPE_COUNT> rentedByType{};     // Unavailable vehicles per type
+
+    /**
+     * @brief Append a row for a vehicle
+     *
+     * @param vehicle The vehicle to append
+     */
+    void push(const Vehicle& vehicle) {
+        passengers.push_back(vehicle.getPassengers());
+        capacity.push_back(vehicle.getCapacity());
+        available.push_back(vehicle.getAvailability());
+        type.push_back(vehicle.getType());
+        lateFee.push_back(vehicle.getLateFee());
+        make.push_back(vehicle.getMakeSymbol());
+        model.push_back(vehicle.getModelSymbol());
+        makeIndex.insert(make.back(), make.size() - 1);
+        modelIndex.insert(model.back(), model.size() - 1);
+        passengersIndex.insert(passengers.back(), passengers.size() - 1);
+        capacityIndex.insert(capacity.back(), capacity.size() - 1);
+        makePrefixes.insert(vehicle.getMake());
+        modelPrefixes.insert(vehicle.getModel());
+        counterFor(type.back(), vehicle.getAvailability())++;
+    }
+
+    /**
+     * @brief Change the availability of row `row`, updating the per-type counters
+     *
+     * @param row The row to update
+     * @param avail The new availability status
+     */
+    void setAvailable(std::size_t row, bool avail) {
+        if (available.test(row) == avail) {
+            return;
+        }
+        counterFor(type[row], !avail)--;
+        counterFor(type[row], avail)++;
+        available.set(row, avail);
+    }
+
+    /**
+     * @brief Take row `row` out of the per-type counters before it is overwritten or truncated
+     *
+     * @param row The row being removed
+     */
+    void release(std::size_t row) {
+        counterFor(type[row], available.test(row))--;
+        makeIndex.erase(make[row], row);
+        modelIndex.erase(model[row], row);
+        passengersIndex.erase(passengers[row], row);
+        capacityIndex.erase(capacity[row], row);
+        makePrefixes.erase(SymbolTable::global().text(make[row]));
+        modelPrefixes.erase(SymbolTable::global().text(model[row]));
+    }
+
+    /**
+     * @brief Copy row `from` over row `to` (row `to` must already have been released)
+     *
+     * @param from The source row
+     * @param to The destination row
+     */
+    void moveRow(std::size_t from, std::size_t to) {
+        passengersIndex.move(passengers[from], from, to);
+        capacityIndex.move(capacity[from], from, to);
+        passengers[to] = passengers[from];
+        capacity[to] = capacity[from];
+        available.set(to, available.test(from));
+        type[to] = type[from];
+        lateFee[to] = lateFee[from];
+        makeIndex.move(make[from], from, to);
+        modelIndex.move(model[from], from, to);
+        make[to] = make[from];
+        model[to] = model[from];
+    }
+
+    /**
+     * @brief Drop all rows from `size` onwards
+     *
+     * @param size The new number of rows
+     */
+    void truncate(std::size_t size) {
+        passengers.resize(size);
+        capacity.resize(size);
+        available.resize(size);
+        type.resize(size);
+        lateFee.resize(size);
+        make.resize(size);
+        model.resize(size);
+        makeIndex.truncate(size);
+        modelIndex.truncate(size);
+        passengersIndex.truncate(size);
+        capacityIndex.truncate(size);
+    }
+
+    /**
+     * @brief Reserve room for `count` rows
+     *
+     * @param count The expected number of rows
+     */
+    void reserve(std::size_t count) {
+        passengers.reserve(count);
+        capacity.reserve(count);
+        available.reserve(count);
+        type.reserve(count);
+        lateFee.reserve(count);
+        make.reserve(count);
+        model.reserve(count);
+        makeIndex.reserve(count);
+        modelIndex.reserve(count);
+        passengersIndex.reserve(count);
+        capacityIndex.reserve(count);
+    }
+
+    /**
+     * @brief Remove all rows
+     */
+    void clear() {
+        truncate(0);
+        makeIndex.clear();
+        modelIndex.clear();
+        passengersIndex.clear();
+        capacityIndex.clear();
+        makePrefixes.clear();
+        modelPrefixes.clear();
+        availableByType.fill(0);
+        rentedByType.fill(0);
+    }
+
+    /**
+     * @brief Call `visit(row)` for every available vehicle, in row order
+     *
+     * @tparam Visitor Callable taking a std::size_t row
+     * @param visit The visitor
+     */
+    template <typename Visitor>
+    void forEachAvailable(Visitor visit) const {
+        available.forEachSetBit(visit);
+    }
+
+    /**
+     * @brief Call `visit(row)` for every available vehicle of one type, in row order
+     *
+     * @tparam Visitor Callable taking a std::size_t row
+     * @param vehicleType The type to visit
+     * @param visit The visitor
+     */
+    template <typename Visitor>
+    void forEachAvailable(VehicleType vehicleType, Visitor visit) const {
+        if (availableByType[static_cast<std::size_t>(vehicleType)] == 0) {
+            return;
+        }
+        available.forEachSetBit([&](std::size_t row) {
+            if (type[row] == vehicleType) {
+                visit(row);
+            }
+        });
+    }
+
+private:
+    std::size_t& counterFor(VehicleType vehicleType, bool avail) {
+        auto& counters = avail ? availableByType : rentedByType;
+        return counters[static_cast<std::size_t>(vehicleType)];
+    }
+};
+
+#endif // VEHICLECOLUMNS_H
@@ -0,0 +1,37 @@
+// VehicleFactory.cpp
+#include "VehicleFactory.h"
+#include "Car.h"
+#include "Van.h"
+#include "Minibus.h"
+#include "SUV.h"
+#include "ObjectPool.h"
+
+/**
+ * The function `makeVehicle` is the single construction path for vehicles. Each concrete type is
+ * allocated with `makePooled`, so all cars share one slab arena, all vans another, and so on.
+ *
+ * @param type The `type` parameter selects the concrete class. `VehicleType::Unknown` falls back to
+ * `Car`, matching how the vehicles file treats lines without a known type.
+ * @param id The `id` parameter is the unique identifier of the vehicle.
+ * @param make The `make` parameter is the make of the vehicle.
+ * @param model The `model` parameter is the model of the vehicle.
+ * @param passengers The `passengers` parameter is the passenger capacity.
+ * @param storage The `storage` parameter is the storage capacity.
+ * @param avail The `avail` parameter is the initial availability status.
+ *
+ * @return A `std::shared_ptr<Vehicle>` to the new vehicle.
+ */
+std::shared_ptr<Vehicle> makeVehicle(VehicleType type, const std::string& id, const std::string& make,
+                                     const std::string& model, int passengers, int storage, bool avail) {
+    switch (type) {
+        case VehicleType::Van:
+            return makePooled<Van>(id, make, model, passengers, storage, avail);
+        case VehicleType::Minibus:
+            return makePooled<Minibus>(id, make, model, passengers, storage, avail);
+        case VehicleType::SUV:
+            return makePooled<SUV>(id, make, model, passengers, storage, avail);
+        case VehicleType::Car:
+        default:
+            return makePooled<Car>(id, make, model, passengers, storage, avail);
+    }
+}
@@ -0,0 +1,24 @@
+// VehicleFactory.h
+#ifndef VEHICLEFACTORY_H
+#define VEHICLEFACTORY_H
+
+#include <memory>
+#include <string>
+#include "Vehicle.h"
+
+/**
+ * @brief Create a vehicle of the given type in its slab arena
+ *
+ * @param type The vehicle type (VehicleType::Unknown creates a Car)
+ * @param id The unique identifier for the vehicle
+ * @param make The make of the vehicle
+ * @param model The model of the vehicle
+ * @param passengers The number of passengers the vehicle can carry
+ * @param storage The storage capacity of the vehicle
+ * @param avail The availability status of the vehicle
+ * @return std::shared_ptr<Vehicle> The new vehicle
+ */
+std::shared_ptr<Vehicle> makeVehicle(VehicleType type, const std::string& id, const std::string& make,
+                                     const std::string& model, int passengers, int storage, bool avail);
+
+#endif // VEHICLEFACTORY_H
@@ -0,0 +1,52 @@
+// VehicleKey.cpp
+#include "VehicleKey.h"
+
+namespace {
+constexpr unsigned DIGIT_COUNT_BITS = 5;
+constexpr VehicleKey DIGIT_COUNT_MASK = (VehicleKey{ 1 } << DIGIT_COUNT_BITS) - 1;
+}
+
+/**
+ * The function `packVehicleID` parses a vehicle ID once into a `VehicleKey` so it can be hashed,
+ * compared and sorted as an integer.
+ *
+ * @param id The `id` parameter is the vehicle ID text. It must be "V" followed by 1 to
+ * `MAX_VEHICLE_KEY_DIGITS` decimal digits to be packable.
+ *
+ * @return The packed key, `(value << 5) | digitCount`, which is never zero for a packable ID, or
+ * `NO_VEHICLE_KEY` if the ID does not have that form.
+ */
+VehicleKey packVehicleID(std::string_view id) {
+    if (id.size() < 2 || id.size() > MAX_VEHICLE_KEY_DIGITS + 1 || id[0] != 'V') {
+        return NO_VEHICLE_KEY;
+    }
+    VehicleKey value = 0;
+    for (std::size_t i = 1; i < id.size(); ++i) {
+        if (id[i] < '0' || id[i] > '9') {
+            return NO_VEHICLE_KEY;
+        }
+        value = value * 10 + static_cast<VehicleKey>(id[i] - '0');
+    }
+    return (value << DIGIT_COUNT_BITS) | static_cast<VehicleKey>(id.size() - 1);
+}
+
+/**
+ * The function `unpackVehicleID` rebuilds the exact ID text from a packed key, including any
+ * leading zeros, so `unpackVehicleID(packVehicleID(id)) == id` for every packable ID.
+ *
+ * @param key The `key` parameter is a key produced by `packVehicleID`.
+ *
+ * @return The vehicle ID text, e.g. "V101".
+ */
+std::string unpackVehicleID(VehicleKey key) {
+    const std::size_t digits = static_cast<std::size_t>(key & DIGIT_COUNT_MASK);
+    VehicleKey value = key >> DIGIT_COUNT_BITS;
+
+    std::string id(digits + 1, '0');
+    id[0] = 'V';
+    for (std::size_t i = digits; i > 0; --i) {
+        id[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return id;
+}
@@ -0,0 +1,36 @@
+// VehicleKey.h
+#ifndef VEHICLEKEY_H
+#define VEHICLEKEY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Vehicle IDs of the form validated by isValidVehicleID ("V" followed by digits) packed into one
+// integer: the numeric value in the high bits and the digit count in the low 5 bits. Keeping the
+// digit count makes the packing lossless ("V007" and "V7" get different keys), and ordering keys
+// orders IDs by numeric value. A key of NO_VEHICLE_KEY means the ID could not be packed (it does
+// not match the pattern or has more than MAX_VEHICLE_KEY_DIGITS digits); such IDs are handled by
+// their text instead.
+using VehicleKey = std::uint64_t;
+
+constexpr VehicleKey NO_VEHICLE_KEY = 0;
+constexpr std::size_t MAX_VEHICLE_KEY_DIGITS = 17; // 10^17 < 2^57, so value << 5 fits in 62 bits
+
+/**
+ * @brief Pack a vehicle ID into an integer key
+ *
+ * @param id The vehicle ID, e.g. "V101"
+ * @return VehicleKey The packed key, or NO_VEHICLE_KEY if the ID cannot be packed
+ */
+VehicleKey packVehicleID(std::string_view id);
+
+/**
+ * @brief Recover the vehicle ID text from a packed key
+ *
+ * @param key A key returned by packVehicleID (not NO_VEHICLE_KEY)
+ * @return std::string The original vehicle ID, e.g. "V101"
+ */
+std::string unpackVehicleID(VehicleKey key);
+
+#endif // VEHICLEKEY_H
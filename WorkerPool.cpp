@@ -0,0 +1,203 @@
+// WorkerPool.cpp
+#include "WorkerPool.h"
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+// Aim for a few chunks per thread so an unlucky slow chunk does not hold up the whole scan, but
+// keep chunks large enough that handing them out costs nothing next to scanning them
+constexpr std::size_t CHUNKS_PER_THREAD = 4;
+constexpr std::size_t MIN_CHUNK_ROWS = 8192;
+
+std::atomic<std::size_t> scanThreshold{ DEFAULT_PARALLEL_SCAN_THRESHOLD };
+std::atomic<std::size_t> scanThreads{ 0 }; // 0 until first use or setParallelScanThreads()
+
+std::size_t hardwareThreads() {
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+/**
+ * The constructor `WorkerPool` starts `threads - 1` worker threads; the thread that calls `run`
+ * is the remaining one.
+ *
+ * @param threads The `threads` parameter is the number of threads working on each job (at least 1).
+ */
+WorkerPool::WorkerPool(std::size_t threads) {
+    const std::size_t count = std::max<std::size_t>(1, threads) - 1;
+    workers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+/**
+ * The destructor `~WorkerPool` wakes every worker with the stop flag set and joins them.
+ */
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * The function `run` publishes a job to the workers, works on it from the calling thread as well,
+ * and returns once every worker has left the job. Tasks are claimed from an atomic counter, so
+ * each index runs exactly once whichever thread picks it up.
+ *
+ * @param tasks The `tasks` parameter is the number of task indexes to run.
+ * @param body The `body` parameter is called once per task index.
+ */
+void WorkerPool::run(std::size_t tasks, const std::function<void(std::size_t)>& body) {
+    std::lock_guard<std::mutex> serial(runMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &body;
+        jobTasks = tasks;
+        nextTask.store(0);
+        busyWorkers = workers.size();
+        failure = nullptr;
+        ++generation;
+    }
+    wake.notify_all();
+
+    drain();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return busyWorkers == 0; });
+        job = nullptr;
+        error = failure;
+        failure = nullptr;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * The function `shared` returns the pool used by the parallel scans, creating it on first use and
+ * re-creating it if the configured thread count has changed since. A replaced pool is not destroyed
+ * here: scans that are still running on it hold their own reference, and the last of them to
+ * finish releases it.
+ *
+ * @return A reference-counted pointer to the shared pool.
+ */
+std::shared_ptr<WorkerPool> WorkerPool::shared() {
+    static std::mutex sharedMutex;
+    static std::shared_ptr<WorkerPool> pool;
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    const std::size_t threads = parallelScanThreads();
+    if (!pool || pool->threadCount() != threads) {
+        pool = std::make_shared<WorkerPool>(threads);
+    }
+    return pool;
+}
+
+/**
+ * The function `workerLoop` is the body of each worker thread: wait for a job it has not worked on
+ * yet, help drain it, report leaving it, and repeat until the pool is destroyed.
+ */
+void WorkerPool::workerLoop() {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        drain();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) {
+            finished.notify_all();
+        }
+    }
+}
+
+/**
+ * The function `drain` claims and runs task indexes of the current job until none are left,
+ * recording the first exception a task throws.
+ */
+void WorkerPool::drain() {
+    for (std::size_t task = nextTask.fetch_add(1); task < jobTasks; task = nextTask.fetch_add(1)) {
+        try {
+            (*job)(task);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+}
+
+/**
+ * The function `setParallelScanThreshold` sets the number of rows below which scans stay on the
+ * calling thread.
+ *
+ * @param rows The `rows` parameter is the new threshold.
+ */
+void setParallelScanThreshold(std::size_t rows) {
+    scanThreshold.store(rows);
+}
+
+/**
+ * The function `parallelScanThreshold` returns the number of rows below which scans stay on the
+ * calling thread.
+ *
+ * @return The threshold in rows.
+ */
+std::size_t parallelScanThreshold() {
+    return scanThreshold.load();
+}
+
+/**
+ * The function `setParallelScanThreads` sets how many threads parallel scans use. The shared pool
+ * is resized the next time a scan needs it.
+ *
+ * @param threads The `threads` parameter is the thread count, or 0 for one per hardware thread.
+ */
+void setParallelScanThreads(std::size_t threads) {
+    scanThreads.store(threads == 0 ? hardwareThreads() : threads);
+}
+
+/**
+ * The function `parallelScanThreads` returns how many threads parallel scans use, defaulting to
+ * one per hardware thread.
+ *
+ * @return The thread count.
+ */
+std::size_t parallelScanThreads() {
+    const std::size_t threads = scanThreads.load();
+    return threads == 0 ? hardwareThreads() : threads;
+}
+
+/**
+ * The function `scanChunkCount` decides how to split a scan. Small scans, and any scan when only
+ * one thread is configured, run as a single chunk on the calling thread; larger ones get a few
+ * chunks per thread, but never chunks smaller than MIN_CHUNK_ROWS.
+ *
+ * @param rows The `rows` parameter is the number of rows to scan.
+ *
+ * @return The number of chunks to split the scan into.
+ */
+std::size_t scanChunkCount(std::size_t rows) {
+    const std::size_t threads = parallelScanThreads();
+    if (threads <= 1 || rows < parallelScanThreshold()) {
+        return 1;
+    }
+    return std::max<std::size_t>(1, std::min(threads * CHUNKS_PER_THREAD, rows / MIN_CHUNK_ROWS));
+}
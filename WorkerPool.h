@@ -0,0 +1,148 @@
+// WorkerPool.h
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Repositories with fewer rows than this are always scanned on the calling thread
+constexpr std::size_t DEFAULT_PARALLEL_SCAN_THRESHOLD = 65536;
+
+// The `WorkerPool` class is a fixed set of threads that run the tasks of one job at a time. run()
+// hands out task indexes from a shared counter, so faster threads pick up more tasks, and the
+// calling thread works on the job too rather than sitting idle. Jobs are serialised: a task must
+// not call run() on the pool that is running it.
+class WorkerPool {
+public:
+    /**
+     * @brief Construct a pool
+     *
+     * @param threads The number of threads working on each job, including the caller of run()
+     */
+    explicit WorkerPool(std::size_t threads);
+
+    /**
+     * @brief Stop and join the worker threads
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Get the number of threads working on each job
+     *
+     * @return std::size_t The worker count plus the calling thread
+     */
+    std::size_t threadCount() const { return workers.size() + 1; }
+
+    /**
+     * @brief Run `body(task)` for every task in [0, tasks) and wait for all of them
+     *
+     * If a task throws, the remaining tasks still run and the first exception is rethrown here.
+     *
+     * @param tasks The number of tasks
+     * @param body The task function; it is called concurrently and must be safe to call so
+     */
+    void run(std::size_t tasks, const std::function<void(std::size_t)>& body);
+
+    /**
+     * @brief Get the pool used by parallel repository scans
+     *
+     * Callers hold the returned pointer for as long as they use the pool: a resize replaces the
+     * shared pool, and the old one is destroyed only once the last scan using it has finished.
+     *
+     * @return std::shared_ptr<WorkerPool> The shared pool, sized by setParallelScanThreads()
+     */
+    static std::shared_ptr<WorkerPool> shared();
+
+private:
+    void workerLoop();
+    void drain();
+
+    std::vector<std::thread> workers;                       // Worker threads (the caller is the extra one)
+    std::mutex runMutex;                                    // Serialises jobs
+    std::mutex mutex;                                       // Guards the job state below
+    std::condition_variable wake;                           // Signals a new job or shutdown
+    std::condition_variable finished;                       // Signals the last worker leaving a job
+    const std::function<void(std::size_t)>* job = nullptr;  // The job being run
+    std::size_t jobTasks = 0;                               // Its task count
+    std::atomic<std::size_t> nextTask{ 0 };                 // Next task index to hand out
+    std::size_t busyWorkers = 0;                            // Workers still inside the job
+    std::uint64_t generation = 0;                           // Incremented per job so workers join each once
+    bool stopping = false;                                  // Set by the destructor
+    std::exception_ptr failure;                             // First exception thrown by a task
+};
+
+/**
+ * @brief Set the repository size at which scans switch to the worker pool
+ *
+ * @param rows The threshold in rows
+ */
+void setParallelScanThreshold(std::size_t rows);
+
+/**
+ * @brief Get the repository size at which scans switch to the worker pool
+ *
+ * @return std::size_t The threshold in rows
+ */
+std::size_t parallelScanThreshold();
+
+/**
+ * @brief Set the number of threads parallel scans use (1 disables parallel scans)
+ *
+ * Scans already running finish on the pool they started with.
+ *
+ * @param threads The thread count; 0 means one per hardware thread
+ */
+void setParallelScanThreads(std::size_t threads);
+
+/**
+ * @brief Get the number of threads parallel scans use
+ *
+ * @return std::size_t The thread count
+ */
+std::size_t parallelScanThreads();
+
+/**
+ * @brief Decide how many chunks a scan of `rows` rows is split into
+ *
+ * @param rows The number of rows to scan
+ * @return std::size_t 1 below the threshold or with a single thread, otherwise a few chunks per thread
+ */
+std::size_t scanChunkCount(std::size_t rows);
+
+/**
+ * @brief Split [0, rows) into `chunks` contiguous ranges and run `body(chunk, begin, end)` for each
+ *
+ * Chunk i covers the rows before chunk i + 1, so callers that keep one result per chunk and join
+ * them in chunk order get the same output as a sequential scan. A single chunk runs on the calling
+ * thread; several run on the shared pool.
+ *
+ * @tparam Body Callable taking (chunk, begin, end)
+ * @param rows The number of rows
+ * @param chunks The number of chunks, from scanChunkCount()
+ * @param body The chunk function
+ */
+template <typename Body>
+void forEachChunk(std::size_t rows, std::size_t chunks, Body body) {
+    if (chunks <= 1) {
+        body(std::size_t{ 0 }, std::size_t{ 0 }, rows);
+        return;
+    }
+    // Keep the pool alive for the whole job even if another thread resizes the shared pool
+    const std::shared_ptr<WorkerPool> pool = WorkerPool::shared();
+    pool->run(chunks, [&](std::size_t chunk) {
+        body(chunk, rows * chunk / chunks, rows * (chunk + 1) / chunks);
+    });
+}
+
+#endif // WORKERPOOL_H
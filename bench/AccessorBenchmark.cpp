@@ -0,0 +1,86 @@
+// AccessorBenchmark.cpp
+//
+// Counts heap allocations made by Repository<Vehicle>::findById and RentalCompany::searchVehicles
+// per vehicle touched. The accessors return references and enum tags, so the only allocations left
+// should be the fixed per-call result buffers, i.e. effectively zero per element.
+#include "RentalCompany.h"
+#include "VehicleFactory.h"
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+std::size_t allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+void report(const char* label, std::size_t allocations, std::size_t elements) {
+    std::cout << std::left << std::setw(40) << label << std::setw(14) << allocations
+              << std::fixed << std::setprecision(6) << static_cast<double>(allocations) / static_cast<double>(elements) << "\n";
+}
+
+} // namespace
+
+int main() {
+    const std::size_t fleetSize = 100000;
+    const std::vector<std::string> makes = { "Ford", "Audi", "Nissan", "Honda", "Seat", "Peugeot", "Toyota", "Mercedes" };
+
+    RentalCompany company;
+    company.setSearchCacheCapacity(0); // Time the searches, not the result cache
+    std::vector<std::string> ids;
+    for (std::size_t i = 0; i < fleetSize; ++i) {
+        ids.push_back("V" + std::to_string(100000 + i));
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(i % 4), ids.back(), makes[i % makes.size()],
+                                       "Model" + std::to_string(i % 50), static_cast<int>(2 + i % 14), static_cast<int>(30 + i % 500), i % 3 != 0));
+    }
+
+    std::cout << std::left << std::setw(40) << "Operation" << std::setw(14) << "Allocations" << "Per element\n";
+
+    std::size_t before = allocationCount;
+    std::size_t found = 0;
+    for (const auto& id : ids) {
+        if (company.getVehicleRepository().findById(id)) {
+            ++found;
+        }
+    }
+    report("findById (every vehicle)", allocationCount - before, found);
+
+    SearchCriteria byAttributes;
+    byAttributes.passengerCapacity = 5;
+    byAttributes.filterByAvailability = true;
+    byAttributes.availability = true;
+    before = allocationCount;
+    auto results = company.searchVehicles(byAttributes);
+    report("searchVehicles (passengers + available)", allocationCount - before, fleetSize);
+
+    SearchCriteria byMakeModel;
+    byMakeModel.make = "Audi";
+    byMakeModel.maxDistanceMake = 0;
+    byMakeModel.model = "Model1";
+    before = allocationCount;
+    results = company.searchVehicles(byMakeModel);
+    report("searchVehicles (exact make + model)", allocationCount - before, fleetSize);
+
+    SearchCriteria fuzzyMake;
+    fuzzyMake.make = "Nisan";
+    before = allocationCount;
+    results = company.searchVehicles(fuzzyMake);
+    report("searchVehicles (fuzzy make)", allocationCount - before, fleetSize);
+
+    return found == fleetSize ? 0 : 1;
+}
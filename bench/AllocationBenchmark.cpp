@@ -0,0 +1,92 @@
+// AllocationBenchmark.cpp
+//
+// Compares heap allocations and time for creating a fleet with std::make_shared (one allocation
+// per object) against the slab arenas used by makeVehicle / makePooled. Global operator new is
+// replaced to count every allocation made by the program.
+#include "VehicleFactory.h"
+#include "ObjectPool.h"
+#include "Customer.h"
+#include "Car.h"
+#include "Van.h"
+#include "Minibus.h"
+#include "SUV.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+std::size_t allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+const std::size_t FLEET_SIZE = 200000;
+const std::size_t CUSTOMER_COUNT = 50000;
+
+std::shared_ptr<Vehicle> makeShared(VehicleType type, const std::string& id) {
+    switch (type) {
+        case VehicleType::Van: return std::make_shared<Van>(id, "Ford", "Transit", 3, 900, true);
+        case VehicleType::Minibus: return std::make_shared<Minibus>(id, "Ford", "Transit", 15, 500, true);
+        case VehicleType::SUV: return std::make_shared<SUV>(id, "Toyota", "Highlander", 7, 50, true);
+        default: return std::make_shared<Car>(id, "Ford", "Fiesta", 5, 40, true);
+    }
+}
+
+template <typename MakeVehicle, typename MakeCustomer>
+void run(const char* label, MakeVehicle createVehicle, MakeCustomer createCustomer, const std::vector<std::string>& ids) {
+    std::vector<std::shared_ptr<Vehicle>> vehicles;
+    std::vector<std::shared_ptr<Customer>> customers;
+    vehicles.reserve(FLEET_SIZE);
+    customers.reserve(CUSTOMER_COUNT);
+
+    const std::size_t before = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < FLEET_SIZE; ++i) {
+        vehicles.push_back(createVehicle(static_cast<VehicleType>(i % 4), ids[i]));
+    }
+    for (std::size_t i = 0; i < CUSTOMER_COUNT; ++i) {
+        customers.push_back(createCustomer(static_cast<int>(i)));
+    }
+    vehicles.clear();
+    customers.clear();
+    ObjectPools::releaseUnused();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << std::left << std::setw(14) << label << std::setw(16) << (allocationCount - before)
+              << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms\n";
+}
+
+} // namespace
+
+int main() {
+    std::vector<std::string> ids;
+    ids.reserve(FLEET_SIZE);
+    for (std::size_t i = 0; i < FLEET_SIZE; ++i) {
+        ids.push_back("V" + std::to_string(i));
+    }
+
+    std::cout << FLEET_SIZE << " vehicles + " << CUSTOMER_COUNT << " customers, created then freed\n";
+    std::cout << std::left << std::setw(14) << "Allocator" << std::setw(16) << "Allocations" << "Time\n";
+    run("make_shared",
+        [](VehicleType type, const std::string& id) { return makeShared(type, id); },
+        [](int id) { return std::make_shared<Customer>(id, "Alice"); }, ids);
+    run("slab arena",
+        [](VehicleType type, const std::string& id) { return makeVehicle(type, id, "Ford", "Fiesta", 5, 40, true); },
+        [](int id) { return makePooled<Customer>(id, "Alice"); }, ids);
+    return 0;
+}
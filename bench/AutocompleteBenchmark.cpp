@@ -0,0 +1,82 @@
+// AutocompleteBenchmark.cpp
+//
+// Times make/model autocomplete from the repository's prefix tries against counting the matching
+// texts with a scan of every vehicle, for prefixes of increasing length, after part of the fleet
+// has been removed again so the tries' removal path is exercised too. Every completion list is
+// checked against the scan.
+#include "RentalCompany.h"
+#include "VehicleFactory.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / 1000.0;
+}
+
+// The scan the tries replace: count every model with the prefix, then keep the most common
+std::vector<Completion> scanCompletions(const std::vector<std::shared_ptr<Vehicle>>& vehicles, const std::string& prefix, std::size_t limit) {
+    std::map<std::string, std::size_t> counts;
+    for (const auto& vehicle : vehicles) {
+        const std::string& model = vehicle->getModel();
+        if (model.compare(0, prefix.size(), prefix) == 0) {
+            ++counts[model];
+        }
+    }
+    std::vector<Completion> completions;
+    for (const auto& entry : counts) {
+        completions.push_back(Completion{ entry.first, entry.second });
+    }
+    std::stable_sort(completions.begin(), completions.end(), [](const Completion& a, const Completion& b) { return a.count > b.count; });
+    completions.resize(std::min(limit, completions.size()));
+    return completions;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t fleetSize = 1000000;
+    const std::size_t modelCount = 20000;
+
+    RentalCompany company;
+    for (std::size_t i = 0; i < fleetSize; ++i) {
+        // Skewed model popularity, so the top completions are well defined
+        const std::size_t model = (i * i + 7 * i) % modelCount % (1 + i % 97 * 200);
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(i % 4), "V" + std::to_string(100000 + i), "Ford",
+                                       "M" + std::to_string(model), 4, 100, true));
+    }
+    for (std::size_t i = 0; i < fleetSize; i += 3) {
+        company.removeVehicle("V" + std::to_string(100000 + i));
+    }
+
+    const std::vector<std::string> prefixes = { "", "M", "M1", "M12", "M123", "M1234" };
+    std::cout << std::left << std::setw(10) << "Prefix" << std::setw(10) << "Top" << std::setw(14) << "Trie us" << "Scan us\n";
+    for (const auto& prefix : prefixes) {
+        auto start = std::chrono::steady_clock::now();
+        const auto completions = company.completeModel(prefix);
+        const double trieUs = elapsedUs(start);
+
+        start = std::chrono::steady_clock::now();
+        const auto scanned = scanCompletions(company.getVehicleRepository().getAll(), prefix, PrefixIndex::MAX_COMPLETIONS);
+        const double scanUs = elapsedUs(start);
+
+        bool same = completions.size() == scanned.size();
+        for (std::size_t i = 0; same && i < completions.size(); ++i) {
+            same = completions[i].text == scanned[i].text && completions[i].count == scanned[i].count;
+        }
+        if (!same) {
+            std::cerr << "Completion mismatch for prefix \"" << prefix << "\"\n";
+            return 1;
+        }
+        std::cout << std::left << std::setw(10) << ("\"" + prefix + "\"") << std::setw(10)
+                  << (completions.empty() ? std::string("-") : completions.front().text) << std::fixed << std::setprecision(1)
+                  << std::setw(14) << trieUs << scanUs << "\n";
+    }
+    return 0;
+}
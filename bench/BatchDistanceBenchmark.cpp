@@ -0,0 +1,79 @@
+// BatchDistanceBenchmark.cpp
+//
+// Compares one-at-a-time boundedLevenshteinDistance with the batched boundedLevenshteinDistances
+// when one query is scanned against many short strings (the searches' scan fallback), and checks
+// that both give the same distances.
+#include "EditDistance.h"
+#include "Utils.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::string randomWord(std::mt19937& rng, std::size_t minLength, std::size_t maxLength) {
+    std::uniform_int_distribution<std::size_t> length(minLength, maxLength);
+    std::uniform_int_distribution<int> letter('a', 'j');
+    std::string word(length(rng), ' ');
+    for (auto& c : word) {
+        c = static_cast<char>(letter(rng));
+    }
+    return word;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+int main() {
+    const std::size_t textCount = 1000000;
+    const std::size_t queryCount = 20;
+    const std::size_t maxDistance = 2;
+
+    std::mt19937 rng(17);
+    std::vector<std::string> store;
+    store.reserve(textCount);
+    for (std::size_t i = 0; i < textCount; ++i) {
+        store.push_back(randomWord(rng, 4, 12));
+    }
+    const std::vector<std::string_view> texts(store.begin(), store.end());
+    std::vector<std::string> queries;
+    for (std::size_t i = 0; i < queryCount; ++i) {
+        queries.push_back(randomWord(rng, 5, 10));
+    }
+
+    std::vector<std::size_t> single(textCount);
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& query : queries) {
+        for (std::size_t i = 0; i < textCount; ++i) {
+            single[i] = boundedLevenshteinDistance(query, texts[i], maxDistance);
+        }
+    }
+    const double singleNs = elapsedNs(start);
+
+    std::vector<std::size_t> batched;
+    start = std::chrono::steady_clock::now();
+    for (const auto& query : queries) {
+        boundedLevenshteinDistances(query, texts, maxDistance, batched);
+    }
+    const double batchedNs = elapsedNs(start);
+
+    // Only the last query's distances are still in both buffers
+    if (batched != single) {
+        std::cerr << "Distance mismatch between single and batched kernels\n";
+        return 1;
+    }
+
+    const double comparisons = static_cast<double>(textCount * queryCount);
+    std::cout << "Batch kernel: " << batchEditDistanceKernel() << "\n";
+    std::cout << std::left << std::setw(12) << "Kernel" << "ns/comparison\n" << std::fixed << std::setprecision(2)
+              << std::setw(12) << "single" << singleNs / comparisons << "\n"
+              << std::setw(12) << "batched" << batchedNs / comparisons << "\n";
+    return 0;
+}
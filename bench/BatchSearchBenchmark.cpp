@@ -0,0 +1,76 @@
+// BatchSearchBenchmark.cpp
+//
+// Replays a nightly matching job: thousands of pending requests (a vehicle type, a minimum number
+// of seats, a misspelt make, sometimes an exact model and the availability filter) run against the
+// fleet, first one searchVehicles call per request and then as a single searchVehiclesBatch call.
+// Every batched result is checked against the one-at-a-time result.
+#include "RentalCompany.h"
+#include "VehicleFactory.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()) / 1000.0;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t fleetSize = 200000;
+    const std::vector<std::size_t> batchSizes = { 100, 1000, 4000 };
+    const std::vector<std::string> makes = { "Ford", "Audi", "Nissan", "Toyota", "Skoda", "Kia", "Honda", "Renault" };
+    const std::vector<std::string> typos = { "Frod", "Adui", "Nisan", "Toyta", "Scoda", "Kai", "Hnoda", "Renalt" };
+    const std::vector<std::string> models = { "Focus", "Fiesta", "A4", "Micra", "Yaris", "Rio", "Octavia", "Civic", "Clio" };
+    const std::vector<std::string> types = { "Car", "Van", "Minibus", "SUV" };
+
+    RentalCompany company;
+    company.setSearchCacheCapacity(0); // Time the searches, not the result cache
+    for (std::size_t i = 0; i < fleetSize; ++i) {
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(i % 4), "V" + std::to_string(100000 + i), makes[i % makes.size()],
+                                       models[(i / 3) % models.size()], static_cast<int>(2 + (i * 7) % 15),
+                                       static_cast<int>((i * 13) % 1000), i % 5 != 0));
+    }
+
+    std::mt19937 rng(24);
+    std::cout << std::left << std::setw(10) << "Queries" << std::setw(16) << "One-by-one ms" << "Batch ms\n";
+    for (std::size_t batchSize : batchSizes) {
+        std::vector<SearchCriteria> queries(batchSize);
+        for (auto& query : queries) {
+            query.type = types[rng() % types.size()];
+            query.make = typos[rng() % typos.size()];
+            query.maxDistanceMake = 1 + rng() % 2;
+            query.minPassengers = static_cast<int>(2 + rng() % 12);
+            if (rng() % 4 == 0) {
+                query.model = models[rng() % models.size()];
+            }
+            query.filterByAvailability = rng() % 2 == 0;
+            query.availability = true;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::vector<std::shared_ptr<Vehicle>>> expected;
+        expected.reserve(queries.size());
+        for (const auto& query : queries) {
+            expected.push_back(company.searchVehicles(query));
+        }
+        const double singleMs = elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        const auto batched = company.searchVehiclesBatch(queries);
+        const double batchMs = elapsedMs(start);
+
+        if (batched != expected) {
+            std::cerr << "Result mismatch for a batch of " << batchSize << "\n";
+            return 1;
+        }
+        std::cout << std::left << std::setw(10) << batchSize << std::fixed << std::setprecision(1)
+                  << std::setw(16) << singleMs << batchMs << "\n";
+    }
+    return 0;
+}
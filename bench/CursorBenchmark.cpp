@@ -0,0 +1,78 @@
+// CursorBenchmark.cpp
+//
+// Times reading one page of search results through the lazy SearchCursor of a VehicleQueryPlan
+// (which filters rows only as they are read) against building the full result vector with
+// searchVehicles and taking the same page from it, for pages near the start and near the end of
+// the matches. Each page is also checked to be identical.
+#include "QueryPlan.h"
+#include "RentalCompany.h"
+#include "VehicleFactory.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace {
+
+double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / 1000.0;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t fleetSize = 1000000;
+    const std::size_t pageSize = 20;
+    const std::vector<std::string> makes = { "Ford", "Audi", "Nissan", "Toyota", "Skoda", "Kia" };
+
+    RentalCompany company;
+    company.setSearchCacheCapacity(0); // Time the searches, not the result cache
+    for (std::size_t i = 0; i < fleetSize; ++i) {
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(i % 4), "V" + std::to_string(100000 + i), makes[i % makes.size()], "Focus",
+                                       static_cast<int>(2 + (i * 7) % 15), static_cast<int>((i * 13) % 1000), i % 3 != 0));
+    }
+
+    struct Query { const char* label; std::string type; std::string make; std::size_t maxDistanceMake; int minStorage; };
+    const std::vector<Query> queries = {
+        { "type Car", "Car", "", 0, -1 },
+        { "make ~Frd, storage >= 500", "", "Frd", 1, 500 },
+        { "no filters", "", "", 0, -1 },
+    };
+
+    std::cout << std::left << std::setw(30) << "Query" << std::setw(10) << "Page" << std::setw(12) << "Matches"
+              << std::setw(14) << "Cursor us" << "Vector us\n";
+    for (const auto& query : queries) {
+        SearchCriteria criteria;
+        criteria.type = query.type;
+        criteria.make = query.make;
+        criteria.maxDistanceMake = query.maxDistanceMake;
+        criteria.minStorage = query.minStorage;
+
+        const std::size_t matchCount = company.searchVehicles(criteria).size();
+        for (std::size_t skip : { std::size_t{ 0 }, matchCount > pageSize ? matchCount - pageSize : 0 }) {
+            auto start = std::chrono::steady_clock::now();
+            auto cursor = VehicleQueryPlan(criteria).cursor(company.getVehicleRepository());
+            cursor.skip(skip).limit(pageSize);
+            std::vector<const Vehicle*> lazyPage;
+            cursor.forEach([&](const Vehicle& vehicle) { lazyPage.push_back(&vehicle); });
+            const double cursorUs = elapsedUs(start);
+
+            start = std::chrono::steady_clock::now();
+            const auto results = company.searchVehicles(criteria);
+            std::vector<const Vehicle*> eagerPage;
+            for (std::size_t i = skip; i < results.size() && eagerPage.size() < pageSize; ++i) {
+                eagerPage.push_back(results[i].get());
+            }
+            const double vectorUs = elapsedUs(start);
+
+            if (lazyPage != eagerPage) {
+                std::cerr << "Page mismatch for " << query.label << " at " << skip << "\n";
+                return 1;
+            }
+            std::cout << std::left << std::setw(30) << query.label << std::setw(10) << (skip == 0 ? "first" : "last")
+                      << std::setw(12) << matchCount << std::fixed << std::setprecision(1) << std::setw(14) << cursorUs << vectorUs << "\n";
+        }
+    }
+    return 0;
+}
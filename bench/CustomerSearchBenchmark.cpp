@@ -0,0 +1,85 @@
+// CustomerSearchBenchmark.cpp
+//
+// Measures fuzzy customer-name search (maxDistance = 2) through the trigram index against comparing
+// the query with every customer's name, and checks that both return the same customers.
+#include "RentalCompany.h"
+#include "ObjectPool.h"
+#include "Utils.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string randomName(std::mt19937& rng) {
+    std::uniform_int_distribution<std::size_t> length(5, 12);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::string name(length(rng), ' ');
+    for (auto& c : name) {
+        c = static_cast<char>(letter(rng));
+    }
+    return name;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::size_t> memberCounts = { 1000, 10000, 100000 };
+    const std::size_t queryCount = 500;
+
+    std::cout << std::left << std::setw(12) << "Customers" << std::setw(16) << "Index us" << "Scan us\n";
+
+    std::mt19937 rng(13);
+    for (std::size_t members : memberCounts) {
+        RentalCompany company;
+        std::vector<std::string> names;
+        for (std::size_t i = 0; i < members; ++i) {
+            names.push_back(randomName(rng));
+            company.addCustomer(makePooled<Customer>(static_cast<int>(1000 + i), names.back()));
+        }
+
+        // Queries are existing names with one typo
+        std::vector<CustomerSearchCriteria> queries(queryCount);
+        std::uniform_int_distribution<std::size_t> pick(0, members - 1);
+        for (auto& query : queries) {
+            query.name = names[pick(rng)];
+            query.name[query.name.size() / 2] = 'x';
+        }
+
+        std::size_t indexHits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& query : queries) {
+            indexHits += company.searchCustomers(query).size();
+        }
+        const double indexNs = elapsedNs(start);
+
+        std::size_t scanHits = 0;
+        const auto& customers = company.getCustomerRepository().getAll();
+        start = std::chrono::steady_clock::now();
+        for (const auto& query : queries) {
+            for (const auto& customer : customers) {
+                if (boundedLevenshteinDistance(customer->getName(), query.name, query.maxDistance) <= query.maxDistance) {
+                    ++scanHits;
+                }
+            }
+        }
+        const double scanNs = elapsedNs(start);
+
+        if (indexHits != scanHits) {
+            std::cerr << "Result mismatch: index " << indexHits << " vs scan " << scanHits << "\n";
+            return 1;
+        }
+
+        std::cout << std::left << std::setw(12) << members << std::fixed << std::setprecision(1)
+                  << std::setw(16) << indexNs / 1000.0 / static_cast<double>(queryCount)
+                  << scanNs / 1000.0 / static_cast<double>(queryCount) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+// DistinctMemoBenchmark.cpp
+//
+// Scans the make column of growing fleets for a fuzzy make, once computing a distance per vehicle
+// and once through SymbolMatchCache (one distance per distinct make). The memoised scan should do a
+// constant number of distance computations however large the fleet grows.
+#include "Repository.h"
+#include "EditDistance.h"
+#include "VehicleFactory.h"
+#include "Utils.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace {
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::size_t> fleetSizes = { 10000, 100000, 1000000 };
+    const std::vector<std::string> makes = { "Ford", "Audi", "Nissan", "Honda", "Seat", "Peugeot", "Toyota", "Mercedes" };
+    const std::string query = "Nisan";
+    const std::size_t maxDistance = 2;
+
+    std::cout << std::left << std::setw(12) << "Fleet" << std::setw(16) << "Per-vehicle us"
+              << std::setw(16) << "Memoised us" << "Distances\n";
+
+    for (std::size_t fleetSize : fleetSizes) {
+        Repository<Vehicle> repository;
+        for (std::size_t i = 0; i < fleetSize; ++i) {
+            repository.add(makeVehicle(VehicleType::Car, "V" + std::to_string(100000 + i), makes[i % makes.size()], "Model", 5, 40, true));
+        }
+        const auto& vehicles = repository.getAll();
+        const auto& column = repository.getColumns().make;
+
+        std::size_t direct = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& vehicle : vehicles) {
+            if (boundedLevenshteinDistance(vehicle->getMake(), query, maxDistance) <= maxDistance) {
+                ++direct;
+            }
+        }
+        const double directNs = elapsedNs(start);
+
+        std::size_t memoised = 0;
+        start = std::chrono::steady_clock::now();
+        SymbolMatchCache cache(query, maxDistance);
+        for (Symbol make : column) {
+            if (cache.matches(make)) {
+                ++memoised;
+            }
+        }
+        const double memoisedNs = elapsedNs(start);
+
+        if (direct != memoised) {
+            std::cerr << "Result mismatch: " << direct << " vs " << memoised << "\n";
+            return 1;
+        }
+
+        std::cout << std::left << std::setw(12) << fleetSize << std::fixed << std::setprecision(1)
+                  << std::setw(16) << directNs / 1000.0 << std::setw(16) << memoisedNs / 1000.0
+                  << cache.evaluated() << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+// FuzzyIndexBenchmark.cpp
+//
+// Measures fuzzy make search (maxDistanceMake = 2) through the symbol trie index against comparing
+// the query with every vehicle's make. Reports how many trie nodes the Levenshtein automaton stepped
+// into per query next to the number of distinct makes, checks that the trie finds exactly the makes
+// a comparison with every distinct make finds, and that both searches return the same vehicles.
+#include "RentalCompany.h"
+#include "SymbolTrie.h"
+#include "VehicleFactory.h"
+#include "Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string randomName(std::mt19937& rng) {
+    std::uniform_int_distribution<std::size_t> length(4, 10);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::string name(length(rng), ' ');
+    for (auto& c : name) {
+        c = static_cast<char>(letter(rng));
+    }
+    name[0] = static_cast<char>(name[0] - 'a' + 'A');
+    return name;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::size_t> distinctCounts = { 100, 1000, 10000 };
+    const std::size_t fleetSize = 200000;
+    const std::size_t queryCount = 200;
+
+    std::cout << std::left << std::setw(12) << "Distinct" << std::setw(16) << "Nodes/query"
+              << std::setw(16) << "Index us" << "Scan us\n";
+
+    std::mt19937 rng(11);
+    for (std::size_t distinct : distinctCounts) {
+        std::vector<std::string> makes;
+        SymbolTrie trie;
+        for (std::size_t i = 0; i < distinct; ++i) {
+            makes.push_back(randomName(rng));
+            trie.insert(SymbolTable::global().intern(makes.back()));
+        }
+
+        RentalCompany company;
+        company.setSearchCacheCapacity(0); // Time the searches, not the result cache
+        for (std::size_t i = 0; i < fleetSize; ++i) {
+            company.addVehicle(makeVehicle(VehicleType::Car, "V" + std::to_string(100000 + i), makes[i % distinct], "Model", 5, 40, true));
+        }
+
+        // Queries are existing makes with one typo, so every query has at least one hit
+        std::vector<SearchCriteria> queries(queryCount);
+        std::uniform_int_distribution<std::size_t> pick(0, distinct - 1);
+        for (auto& query : queries) {
+            query.make = makes[pick(rng)];
+            query.make[query.make.size() / 2] = 'x';
+            query.maxDistanceMake = 2;
+        }
+
+        std::size_t stepped = 0;
+        for (const auto& query : queries) {
+            std::vector<Symbol> matches;
+            stepped += trie.search(query.make, query.maxDistanceMake, matches);
+
+            std::vector<Symbol> expected;
+            for (const auto& make : makes) {
+                if (boundedLevenshteinDistance(make, query.make, query.maxDistanceMake) <= query.maxDistanceMake) {
+                    expected.push_back(SymbolTable::global().intern(make));
+                }
+            }
+            std::sort(matches.begin(), matches.end());
+            std::sort(expected.begin(), expected.end());
+            expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+            if (matches != expected) {
+                std::cerr << "Trie mismatch for \"" << query.make << "\"\n";
+                return 1;
+            }
+        }
+
+        std::size_t indexHits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& query : queries) {
+            indexHits += company.searchVehicles(query).size();
+        }
+        const double indexNs = elapsedNs(start);
+
+        std::size_t scanHits = 0;
+        const auto& vehicles = company.getVehicleRepository().getAll();
+        start = std::chrono::steady_clock::now();
+        for (const auto& query : queries) {
+            for (const auto& vehicle : vehicles) {
+                if (boundedLevenshteinDistance(vehicle->getMake(), query.make, query.maxDistanceMake) <= query.maxDistanceMake) {
+                    ++scanHits;
+                }
+            }
+        }
+        const double scanNs = elapsedNs(start);
+
+        if (indexHits != scanHits) {
+            std::cerr << "Result mismatch: index " << indexHits << " vs scan " << scanHits << "\n";
+            return 1;
+        }
+
+        std::cout << std::left << std::setw(12) << distinct << std::fixed << std::setprecision(1)
+                  << std::setw(16) << static_cast<double>(stepped) / static_cast<double>(queryCount)
+                  << std::setw(16) << indexNs / 1000.0 / static_cast<double>(queryCount)
+                  << scanNs / 1000.0 / static_cast<double>(queryCount) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+// LevenshteinBenchmark.cpp
+//
+// Compares the full-matrix levenshteinDistance with boundedLevenshteinDistance on random word pairs
+// at the thresholds the searches use. Every pair is also checked for agreement: the bounded kernel
+// must return the exact distance when it is within the threshold and threshold + 1 otherwise.
+#include "Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+volatile std::size_t sink = 0; // Keeps the timed loops from being optimised away
+
+std::string randomWord(std::mt19937& rng, std::size_t minLength, std::size_t maxLength) {
+    std::uniform_int_distribution<std::size_t> length(minLength, maxLength);
+    std::uniform_int_distribution<int> letter('a', 'h'); // Small alphabet so near matches are common
+    std::string word(length(rng), ' ');
+    for (auto& c : word) {
+        c = static_cast<char>(letter(rng));
+    }
+    return word;
+}
+
+// Applies a few random edits so a share of the pairs fall inside the threshold
+std::string mutate(std::mt19937& rng, std::string word, std::size_t edits) {
+    std::uniform_int_distribution<int> letter('a', 'h');
+    for (std::size_t i = 0; i < edits && !word.empty(); ++i) {
+        std::uniform_int_distribution<std::size_t> at(0, word.size() - 1);
+        switch (rng() % 3) {
+        case 0: word[at(rng)] = static_cast<char>(letter(rng)); break;
+        case 1: word.erase(at(rng), 1); break;
+        default: word.insert(at(rng), 1, static_cast<char>(letter(rng))); break;
+        }
+    }
+    return word;
+}
+
+template <typename F>
+double timePairs(const std::vector<std::pair<std::string, std::string>>& pairs, std::size_t& checksum, F distance) {
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& pair : pairs) {
+        checksum += distance(pair.first, pair.second);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(pairs.size());
+}
+
+} // namespace
+
+int main() {
+    struct Shape { std::size_t minLength, maxLength, threshold; };
+    const std::vector<Shape> shapes = { { 3, 12, 0 }, { 3, 12, 2 }, { 20, 60, 2 }, { 80, 200, 3 } };
+    const std::size_t pairCount = 200000;
+
+    std::cout << std::left << std::setw(12) << "Lengths" << std::setw(12) << "Threshold"
+              << std::setw(16) << "Matrix ns" << "Bounded ns\n";
+
+    std::mt19937 rng(7);
+    for (const auto& shape : shapes) {
+        const std::size_t count = shape.maxLength > 64 ? pairCount / 20 : pairCount;
+        std::vector<std::pair<std::string, std::string>> pairs;
+        pairs.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string word = randomWord(rng, shape.minLength, shape.maxLength);
+            std::string other = (i % 2 == 0) ? mutate(rng, word, rng() % 4) : randomWord(rng, shape.minLength, shape.maxLength);
+            pairs.emplace_back(std::move(word), std::move(other));
+        }
+
+        for (const auto& pair : pairs) {
+            std::size_t exact = levenshteinDistance(pair.first, pair.second);
+            std::size_t bounded = boundedLevenshteinDistance(pair.first, pair.second, shape.threshold);
+            if (bounded != std::min(exact, shape.threshold + 1)) {
+                std::cerr << "Mismatch on \"" << pair.first << "\" / \"" << pair.second << "\": "
+                          << exact << " vs " << bounded << "\n";
+                return 1;
+            }
+        }
+
+        std::size_t checksum = 0;
+        double matrix = timePairs(pairs, checksum, [](const std::string& a, const std::string& b) {
+            return levenshteinDistance(a, b);
+        });
+        double bounded = timePairs(pairs, checksum, [&shape](const std::string& a, const std::string& b) {
+            return boundedLevenshteinDistance(a, b, shape.threshold);
+        });
+
+        std::cout << std::left << std::setw(12) << (std::to_string(shape.minLength) + "-" + std::to_string(shape.maxLength))
+                  << std::setw(12) << shape.threshold << std::fixed << std::setprecision(1)
+                  << std::setw(16) << matrix << bounded << "\n";
+        sink = checksum;
+    }
+    return 0;
+}
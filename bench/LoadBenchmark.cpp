@@ -0,0 +1,51 @@
+// LoadBenchmark.cpp
+//
+// Times RentalCompany::loadFromFile on a synthetic vehicles file of one million lines (plus a
+// handful of duplicate IDs), exercising the single-pass bulk ingest path.
+#include "RentalCompany.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main() {
+    const std::size_t vehicleCount = 1000000;
+    const std::size_t duplicateCount = 5;
+    const std::vector<std::string> types = { "Car", "Van", "Minibus", "SUV" };
+    const std::vector<std::string> makes = { "Ford", "Audi", "Nissan", "Honda", "Seat", "Peugeot", "Toyota", "Mercedes" };
+
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string vehiclesFile = (dir / "bench_vehicles.txt").string();
+    const std::string customersFile = (dir / "bench_customers.txt").string();
+
+    {
+        std::ofstream vFile(vehiclesFile);
+        for (std::size_t i = 0; i < vehicleCount + duplicateCount; ++i) {
+            const std::size_t id = i < vehicleCount ? i : i - vehicleCount; // Tail re-uses early IDs
+            vFile << types[i % types.size()] << " V" << (100000 + id) << " \"" << makes[i % makes.size()]
+                  << "\" \"Model" << (i % 97) << "\" " << (2 + i % 14) << " " << (30 + i % 500) << " " << (i % 3 != 0) << "\n";
+        }
+        std::ofstream cFile(customersFile);
+    }
+
+    RentalCompany company;
+    auto start = std::chrono::steady_clock::now();
+    company.loadFromFile(vehiclesFile, customersFile);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::remove(vehiclesFile.c_str());
+    std::remove(customersFile.c_str());
+
+    const std::size_t loaded = company.getVehicleRepository().getAll().size();
+    if (loaded != vehicleCount) {
+        std::cerr << "Expected " << vehicleCount << " vehicles, loaded " << loaded << "\n";
+        return 1;
+    }
+
+    std::cout << "Loaded " << loaded << " vehicles in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms\n";
+    return 0;
+}
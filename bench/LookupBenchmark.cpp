@@ -0,0 +1,81 @@
+// LookupBenchmark.cpp
+//
+// Measures Repository<Vehicle>::findById as the fleet grows, next to the linear std::find_if over
+// the vehicle list it replaced. The hash index does the same constant work per lookup at every
+// size while the scan grows with the fleet; what growth the index column still shows comes from
+// the table and the vehicles no longer fitting in cache, so random lookups miss it more often.
+#include "Repository.h"
+#include "Car.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+int main() {
+    const std::vector<std::size_t> fleetSizes = { 1000, 10000, 100000, 1000000 };
+    const std::size_t lookups = 200000;
+
+    std::cout << std::left << std::setw(12) << "Fleet" << std::setw(16) << "Lookups"
+              << std::setw(16) << "ns/lookup" << "ns/linear scan\n";
+
+    for (std::size_t fleetSize : fleetSizes) {
+        Repository<Vehicle> repository;
+        for (std::size_t i = 0; i < fleetSize; ++i) {
+            repository.add(std::make_shared<Car>("V" + std::to_string(100000 + i), "Ford", "Fiesta", 5, 40, true));
+        }
+
+        // Pre-build the query IDs so only the lookup itself is timed
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<std::size_t> pick(0, fleetSize - 1);
+        std::vector<std::string> queries;
+        queries.reserve(lookups);
+        for (std::size_t i = 0; i < lookups; ++i) {
+            queries.push_back("V" + std::to_string(100000 + pick(rng)));
+        }
+
+        std::size_t found = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& id : queries) {
+            if (repository.findById(id)) {
+                ++found;
+            }
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        if (found != lookups) {
+            std::cerr << "Lookup mismatch: found " << found << " of " << lookups << "\n";
+            return 1;
+        }
+
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        // The linear scan is timed on fewer queries, so the large fleets finish in seconds
+        const std::size_t scans = std::max<std::size_t>(100, 20000000 / fleetSize);
+        const auto& vehicles = repository.getAll();
+        found = 0;
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < scans; ++i) {
+            auto it = std::find_if(vehicles.begin(), vehicles.end(), [&](const std::shared_ptr<Vehicle>& vehicle) {
+                return vehicle->getVehicleID() == queries[i];
+            });
+            if (it != vehicles.end()) {
+                ++found;
+            }
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+
+        if (found != scans) {
+            std::cerr << "Scan mismatch: found " << found << " of " << scans << "\n";
+            return 1;
+        }
+
+        double scanNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        std::cout << std::left << std::setw(12) << fleetSize << std::setw(16) << lookups
+                  << std::fixed << std::setprecision(1) << std::setw(16) << ns / static_cast<double>(lookups)
+                  << scanNs / static_cast<double>(scans) << "\n";
+    }
+    return 0;
+}
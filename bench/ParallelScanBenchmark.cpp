@@ -0,0 +1,79 @@
+// ParallelScanBenchmark.cpp
+//
+// Times full repository scans on a multi-million-row fleet with the worker pool set to 1, 2, 4 and
+// 8 threads: searchItems with a predicate on the vehicle objects, and searchVehicles with filters
+// that have no index (type and rented status) so the query plan narrows every row. Every
+// multi-threaded result is checked against the single-threaded one. Speed-ups are bounded by the
+// number of hardware threads reported on the first line.
+#include "RentalCompany.h"
+#include "Utils.h"
+#include "VehicleFactory.h"
+#include "WorkerPool.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()) / 1000.0;
+}
+
+// Best of a few runs, to keep scheduler noise out of the comparison
+template <typename F>
+double bestOf(int runs, F scan) {
+    double best = 0.0;
+    for (int run = 0; run < runs; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        scan();
+        const double ms = elapsedMs(start);
+        best = (run == 0 || ms < best) ? ms : best;
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t fleetSize = 2000000;
+    const std::vector<std::string> makes = { "Ford", "Audi", "Nissan", "Toyota", "Skoda", "Kia" };
+
+    RentalCompany company;
+    company.setSearchCacheCapacity(0); // Time the searches, not the result cache
+    for (std::size_t i = 0; i < fleetSize; ++i) {
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(i % 4), "V" + std::to_string(100000 + i), makes[i % makes.size()], "Focus",
+                                       static_cast<int>(2 + (i * 7) % 15), static_cast<int>((i * 13) % 1000), i % 3 != 0));
+    }
+
+    SearchCriteria criteria;
+    criteria.type = "Car";
+    criteria.filterByAvailability = true;
+    criteria.availability = false;
+    auto roomy = [](const std::shared_ptr<Vehicle>& vehicle) { return vehicle->getPassengers() >= 7 && vehicle->getCapacity() < 500; };
+
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << ", fleet: " << fleetSize << "\n";
+    std::cout << std::left << std::setw(10) << "Threads" << std::setw(18) << "searchItems ms" << "searchVehicles ms\n";
+
+    setParallelScanThreads(1);
+    const auto expectedItems = searchItems(company.getVehicleRepository(), roomy);
+    const auto expectedVehicles = company.searchVehicles(criteria);
+
+    for (std::size_t threads : { 1, 2, 4, 8 }) {
+        setParallelScanThreads(threads);
+        std::vector<std::shared_ptr<Vehicle>> items;
+        std::vector<std::shared_ptr<Vehicle>> vehicles;
+        const double itemsMs = bestOf(3, [&] { items = searchItems(company.getVehicleRepository(), roomy); });
+        const double vehiclesMs = bestOf(3, [&] { vehicles = company.searchVehicles(criteria); });
+
+        if (items != expectedItems || vehicles != expectedVehicles) {
+            std::cerr << "Result mismatch at " << threads << " threads\n";
+            return 1;
+        }
+        std::cout << std::left << std::setw(10) << threads << std::fixed << std::setprecision(1)
+                  << std::setw(18) << itemsMs << vehiclesMs << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+// QueryPlanBenchmark.cpp
+//
+// Times RentalCompany::searchVehicles (compiled VehicleQueryPlan) against evaluating every
+// predicate on every vehicle, for a few mixed criteria on a large fleet, and checks both agree.
+#include "RentalCompany.h"
+#include "VehicleFactory.h"
+#include "Utils.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace {
+
+double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / 1000.0;
+}
+
+bool matchesNaively(const Vehicle& vehicle, const SearchCriteria& criteria) {
+    if (!criteria.type.empty() && vehicle.getType() != vehicleTypeFromString(criteria.type)) return false;
+    if (!criteria.make.empty() && levenshteinDistance(vehicle.getMake(), criteria.make) > criteria.maxDistanceMake) return false;
+    if (!criteria.model.empty() && levenshteinDistance(vehicle.getModel(), criteria.model) > criteria.maxDistanceModel) return false;
+    if (criteria.passengerCapacity != -1 && vehicle.getPassengers() != criteria.passengerCapacity) return false;
+    if (criteria.storageCapacity != -1 && vehicle.getCapacity() != criteria.storageCapacity) return false;
+    if (criteria.filterByAvailability && vehicle.getAvailability() != criteria.availability) return false;
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t fleetSize = 500000;
+    const std::vector<std::string> makes = { "Ford", "Audi", "Nissan", "Honda", "Seat", "Peugeot", "Toyota", "Mercedes" };
+
+    RentalCompany company;
+    company.setSearchCacheCapacity(0); // Time the searches, not the result cache
+    for (std::size_t i = 0; i < fleetSize; ++i) {
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(i % 4), "V" + std::to_string(100000 + i), makes[i % makes.size()],
+                                       "Model" + std::to_string(i % 200), static_cast<int>(2 + i % 14), static_cast<int>(30 + i % 500), i % 3 != 0));
+    }
+
+    std::vector<std::pair<std::string, SearchCriteria>> queries(3);
+    queries[0].first = "fuzzy make + passengers";
+    queries[0].second.make = "Nisan";
+    queries[0].second.passengerCapacity = 6;
+    queries[1].first = "exact make + fuzzy model";
+    queries[1].second.make = "Audi";
+    queries[1].second.maxDistanceMake = 0;
+    queries[1].second.model = "Modl17";
+    queries[1].second.maxDistanceModel = 1;
+    queries[2].first = "type + available + fuzzy make";
+    queries[2].second.type = "SUV";
+    queries[2].second.filterByAvailability = true;
+    queries[2].second.availability = true;
+    queries[2].second.make = "Hond";
+
+    std::cout << std::left << std::setw(32) << "Query" << std::setw(12) << "Matches" << std::setw(14) << "Plan us" << "Naive us\n";
+    const auto& vehicles = company.getVehicleRepository().getAll();
+    for (const auto& query : queries) {
+        auto start = std::chrono::steady_clock::now();
+        const auto planned = company.searchVehicles(query.second);
+        const double planUs = elapsedUs(start);
+
+        std::vector<std::shared_ptr<Vehicle>> naive;
+        start = std::chrono::steady_clock::now();
+        for (const auto& vehicle : vehicles) {
+            if (matchesNaively(*vehicle, query.second)) {
+                naive.push_back(vehicle);
+            }
+        }
+        const double naiveUs = elapsedUs(start);
+
+        if (planned != naive) {
+            std::cerr << "Result mismatch for " << query.first << "\n";
+            return 1;
+        }
+        std::cout << std::left << std::setw(32) << query.first << std::setw(12) << planned.size() << std::fixed
+                  << std::setprecision(1) << std::setw(14) << planUs << naiveUs << "\n";
+    }
+    return 0;
+}
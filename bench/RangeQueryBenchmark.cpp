@@ -0,0 +1,74 @@
+// RangeQueryBenchmark.cpp
+//
+// Times passenger and storage range searches served by the sorted RangeIndex against a scan of
+// every vehicle, for ranges of different selectivity, and checks both agree.
+#include "RentalCompany.h"
+#include "VehicleFactory.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace {
+
+double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / 1000.0;
+}
+
+bool inRange(int value, int minimum, int maximum) {
+    return (minimum == -1 || value >= minimum) && (maximum == -1 || value <= maximum);
+}
+
+} // namespace
+
+int main() {
+    const std::size_t fleetSize = 1000000;
+
+    RentalCompany company;
+    company.setSearchCacheCapacity(0); // Time the searches, not the result cache
+    for (std::size_t i = 0; i < fleetSize; ++i) {
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(i % 4), "V" + std::to_string(100000 + i), "Ford", "Focus",
+                                       static_cast<int>(2 + (i * 7) % 15), static_cast<int>((i * 13) % 1000), true));
+    }
+
+    struct RangeQuery { const char* label; int minPassengers, maxPassengers, minStorage, maxStorage; };
+    const std::vector<RangeQuery> queries = {
+        { "passengers >= 7", 7, -1, -1, -1 },
+        { "passengers >= 16", 16, -1, -1, -1 },
+        { "storage 40..80", -1, -1, 40, 80 },
+        { "storage 40..80, passengers 7..9", 7, 9, 40, 80 },
+    };
+
+    std::cout << std::left << std::setw(36) << "Query" << std::setw(12) << "Matches" << std::setw(14) << "Index us" << "Scan us\n";
+    const auto& vehicles = company.getVehicleRepository().getAll();
+    for (const auto& query : queries) {
+        SearchCriteria criteria;
+        criteria.minPassengers = query.minPassengers;
+        criteria.maxPassengers = query.maxPassengers;
+        criteria.minStorage = query.minStorage;
+        criteria.maxStorage = query.maxStorage;
+
+        auto start = std::chrono::steady_clock::now();
+        const auto indexed = company.searchVehicles(criteria);
+        const double indexUs = elapsedUs(start);
+
+        std::vector<std::shared_ptr<Vehicle>> scanned;
+        start = std::chrono::steady_clock::now();
+        for (const auto& vehicle : vehicles) {
+            if (inRange(vehicle->getPassengers(), query.minPassengers, query.maxPassengers)
+                && inRange(vehicle->getCapacity(), query.minStorage, query.maxStorage)) {
+                scanned.push_back(vehicle);
+            }
+        }
+        const double scanUs = elapsedUs(start);
+
+        if (indexed != scanned) {
+            std::cerr << "Result mismatch for " << query.label << "\n";
+            return 1;
+        }
+        std::cout << std::left << std::setw(36) << query.label << std::setw(12) << indexed.size() << std::fixed
+                  << std::setprecision(1) << std::setw(14) << indexUs << scanUs << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+// RankedSearchBenchmark.cpp
+//
+// Compares searchVehiclesRanked (bounded top-k heap with early stop) against materialising every
+// match with searchVehicles, for the top 20 of a broad fuzzy query. The ranked search never builds
+// the full result vector, so it is cheaper than merely materialising the matches.
+#include "RentalCompany.h"
+#include "VehicleFactory.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace {
+
+double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / 1000.0;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t fleetSize = 1000000;
+    const std::size_t limit = DEFAULT_RANKED_LIMIT;
+    const std::vector<std::string> makes = { "Ford", "Fort", "Forde", "Audi", "Nissan", "Honda", "Seat", "Toyota" };
+
+    RentalCompany company;
+    company.setSearchCacheCapacity(0); // Time the searches, not the result cache
+    for (std::size_t i = 0; i < fleetSize; ++i) {
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(i % 4), "V" + std::to_string(100000 + i), makes[i % makes.size()],
+                                       "Focus", static_cast<int>(2 + (i * 7) % 15), static_cast<int>((i * 13) % 1000), true));
+    }
+
+    SearchCriteria criteria;
+    criteria.make = "Ford";
+    criteria.minPassengers = 5;
+
+    auto start = std::chrono::steady_clock::now();
+    const auto everything = company.searchVehicles(criteria);
+    const double fullUs = elapsedUs(start);
+
+    start = std::chrono::steady_clock::now();
+    const auto ranked = company.searchVehiclesRanked(criteria, limit);
+    const double rankedUs = elapsedUs(start);
+
+    std::cout << "Top " << limit << " of a fuzzy make + minimum passengers query over " << fleetSize << " vehicles\n";
+    std::cout << std::left << std::setw(28) << "Approach" << "us\n" << std::fixed << std::setprecision(1)
+              << std::setw(28) << "materialise all matches" << fullUs << " (" << everything.size() << " vehicles)\n"
+              << std::setw(28) << "ranked top-k" << rankedUs << "\n";
+    std::cout << "Best score " << (ranked.empty() ? 0.0 : ranked.front().score) << ", worst kept "
+              << (ranked.empty() ? 0.0 : ranked.back().score) << "\n";
+    return ranked.size() == limit ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+// SearchCacheBenchmark.cpp
+//
+// Replays the kind of query sequence the interactive vehicle search menu produces (each step adds
+// one criterion, then the last search is viewed again) with and without the result cache. With the
+// cache on, refinements narrow the previous result and repeats are lookups. A vehicle is then
+// added, which must invalidate the cached results. Every result is checked against the uncached one.
+#include "QueryPlan.h"
+#include "RentalCompany.h"
+#include "VehicleFactory.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace {
+
+double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / 1000.0;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t fleetSize = 1000000;
+    const std::vector<std::string> makes = { "Ford", "Audi", "Nissan", "Toyota", "Skoda", "Kia" };
+    const std::vector<std::string> models = { "Focus", "Fiesta", "A4", "Micra", "Yaris", "Rio", "Octavia" };
+
+    RentalCompany company;
+    for (std::size_t i = 0; i < fleetSize; ++i) {
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(i % 4), "V" + std::to_string(100000 + i), makes[i % makes.size()],
+                                       models[(i / 3) % models.size()], static_cast<int>(2 + (i * 7) % 15),
+                                       static_cast<int>((i * 13) % 1000), i % 5 != 0));
+    }
+
+    // Each step refines the one before it, as when criteria are set one menu option at a time
+    std::vector<std::pair<std::string, SearchCriteria>> steps;
+    SearchCriteria criteria;
+    criteria.type = "Car";
+    steps.emplace_back("type Car", criteria);
+    criteria.make = "Frod";
+    criteria.maxDistanceMake = 2;
+    steps.emplace_back("+ make ~Frod", criteria);
+    criteria.model = "Fokus";
+    criteria.maxDistanceModel = 1;
+    steps.emplace_back("+ model ~Fokus", criteria);
+    criteria.minPassengers = 8;
+    steps.emplace_back("+ passengers >= 8", criteria);
+    steps.emplace_back("view again", criteria);
+
+    std::cout << std::left << std::setw(22) << "Step" << std::setw(12) << "Matches" << std::setw(16) << "Uncached us" << "Cached us\n";
+    auto replay = [&](const char* note) {
+        for (const auto& step : steps) {
+            // Uncached: what searchVehicles does without the cache
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::shared_ptr<Vehicle>> expected;
+            for (std::size_t position : VehicleQueryPlan(step.second).execute(company.getVehicleRepository())) {
+                expected.push_back(company.getVehicleRepository().getAll()[position]);
+            }
+            const double uncachedUs = elapsedUs(start);
+
+            start = std::chrono::steady_clock::now();
+            const auto cached = company.searchVehicles(step.second);
+            const double cachedUs = elapsedUs(start);
+
+            if (cached != expected) {
+                std::cerr << "Result mismatch at \"" << step.first << "\" " << note << "\n";
+                return false;
+            }
+            std::cout << std::left << std::setw(22) << step.first << std::setw(12) << cached.size() << std::fixed
+                      << std::setprecision(1) << std::setw(16) << uncachedUs << cachedUs << "\n";
+        }
+        return true;
+    };
+
+    if (!replay("(first pass)")) {
+        return 1;
+    }
+
+    std::cout << "-- after adding a vehicle --\n";
+    company.addVehicle(makeVehicle(VehicleType::Car, "V9999999", "Ford", "Focus", 9, 10, true));
+    return replay("(after adding a vehicle)") ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// StandingQueryBenchmark.cpp
+//
+// Keeps dispatch-screen style standing queries ("available 7-seat Minibus" and the like) open on a
+// large fleet while vehicles are rented, returned, added and removed, and compares the cost of the
+// deltas each change produces with re-running every query once, which is what a screen refreshing
+// on a timer pays per tick. At the end, every subscriber's view (built only from deltas) is checked
+// against a fresh search.
+#include "RentalCompany.h"
+#include "DateUtils.h"
+#include "VehicleFactory.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / 1000.0;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t fleetSize = 500000;
+    const std::size_t changes = 4000;
+    const std::vector<std::string> makes = { "Ford", "Audi", "Nissan", "Toyota", "Skoda", "Kia" };
+    const std::vector<std::string> types = { "Car", "Van", "Minibus", "SUV" };
+
+    RentalCompany company;
+    company.setSearchCacheCapacity(0); // Time the searches, not the result cache
+    for (std::size_t i = 0; i < fleetSize; ++i) {
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(i % 4), "V" + std::to_string(100000 + i), makes[i % makes.size()], "Focus",
+                                       static_cast<int>(2 + (i * 7) % 15), static_cast<int>((i * 13) % 1000), i % 3 != 0));
+    }
+    company.addCustomer(std::make_shared<Customer>(1, "Dispatch"));
+
+    std::vector<SearchCriteria> queries;
+    for (const auto& type : types) {
+        for (int seats : { 4, 7, 12 }) {
+            SearchCriteria criteria;
+            criteria.type = type;
+            criteria.minPassengers = seats;
+            criteria.filterByAvailability = true;
+            criteria.availability = true;
+            queries.push_back(criteria);
+        }
+    }
+    SearchCriteria fuzzy;
+    fuzzy.make = "Frod";
+    fuzzy.minPassengers = 9;
+    queries.push_back(fuzzy);
+
+    std::map<SubscriptionId, std::set<std::shared_ptr<Vehicle>>> views;
+    std::map<SubscriptionId, SearchCriteria> subscribed;
+    for (const auto& criteria : queries) {
+        const SubscriptionId id = company.subscribe(criteria, [&views](SubscriptionId changed, const SearchDelta& delta) {
+            auto& view = views[changed];
+            for (const auto& vehicle : delta.removed) {
+                view.erase(vehicle);
+            }
+            view.insert(delta.added.begin(), delta.added.end());
+        });
+        subscribed.emplace(id, criteria);
+    }
+
+    // Rentals print a receipt; keep it out of the report
+    std::ostringstream receipts;
+    std::streambuf* console = std::cout.rdbuf(receipts.rdbuf());
+    const std::string today = DateUtils::getCurrentDate();
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < changes; ++i) {
+        const std::string id = "V" + std::to_string(100001 + (i * 7919) % (fleetSize - 1));
+        switch (i % 4) {
+        case 0:
+            if (company.searchVehicle(id)->getAvailability()) {
+                company.rentVehicle(1, id);
+                company.returnVehicle(1, id, today);
+            }
+            break;
+        case 1:
+            company.addVehicle(makeVehicle(VehicleType::Minibus, "V" + std::to_string(9000000 + i), "Ford", "Transit", 12, 300, true));
+            break;
+        case 2:
+            company.removeVehicle("V" + std::to_string(9000000 + i - 1));
+            break;
+        default:
+            if (company.searchVehicle(id)->getAvailability()) {
+                company.rentVehicle(1, id);
+            }
+            break;
+        }
+    }
+    const double deltaUs = elapsedUs(start);
+    std::cout.rdbuf(console);
+
+    start = std::chrono::steady_clock::now();
+    bool same = true;
+    for (const auto& entry : subscribed) {
+        const auto fresh = company.searchVehicles(entry.second);
+        same = same && std::set<std::shared_ptr<Vehicle>>(fresh.begin(), fresh.end()) == views[entry.first];
+    }
+    const double refreshUs = elapsedUs(start);
+    if (!same) {
+        std::cerr << "A standing query's view differs from a fresh search\n";
+        return 1;
+    }
+
+    std::cout << subscribed.size() << " standing queries over " << fleetSize << " vehicles\n" << std::fixed << std::setprecision(1)
+              << std::left << std::setw(34) << "Deltas per fleet change us" << deltaUs / static_cast<double>(changes) << "\n"
+              << std::setw(34) << "Re-running every query us" << refreshUs << "\n";
+    return 0;
+}
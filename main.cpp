@@ -16,6 +16,9 @@
 #include "Minibus.h"
 #include "SUV.h"
 #include "DateUtils.h"
+#include "ObjectPool.h"
+#include "VehicleFactory.h"
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <string>
@@ -37,8 +40,9 @@ void handleDisplayAvailableVehicles(RentalCompany& company);
 void handleDisplayCustomers(RentalCompany& company);
 void handleSearchVehicles(RentalCompany& company);
 void handleSearchCustomers(RentalCompany& company);
-void displayVehicleSearchResults(const std::vector<std::shared_ptr<Vehicle>>& results);
-void displayCustomerSearchResults(const std::vector<std::shared_ptr<Customer>>& results);
+void displayVehicleSearchResults(SearchCursor<Vehicle>& results);
+void displayCustomerSearchResults(SearchCursor<Customer>& results);
+std::string readWithCompletion(const std::function<std::vector<Completion>(const std::string&)>& complete);
 void handleAddCustomer(RentalCompany& company);
 void handleAddVehicle(RentalCompany& company);
 void handleDisplayAllVehicles(RentalCompany& company);
@@ -277,7 +281,7 @@ void runSpecificTests(RentalCompany& company) {
     // Test 2: Adding new Car - V108 Vauxhall Corsa...
     std::cout << "Test 2: Adding new Car - V108 Vauxhall Corsa...\n";
     try {
-        auto car = std::make_shared<Car>("V108", "Vauxhall", "Corsa", 5, 300, true);
+        auto car = makeVehicle(VehicleType::Car, "V108", "Vauxhall", "Corsa", 5, 300, true);
         company.addVehicle(car);
         std::cout << "Test 2 PASSED: Car V108 Vauxhall Corsa added successfully.\n\n";
     } catch (const std::exception& e) {
@@ -287,7 +291,7 @@ void runSpecificTests(RentalCompany& company) {
     // Test 3: Adding new Customer - Christina (ID:106)...
     std::cout << "Test 3: Adding new Customer - Christina (ID:106)...\n";
     try {
-        auto customer = std::make_shared<Customer>(106, "Christina");
+        auto customer = makePooled<Customer>(106, "Christina");
         company.addCustomer(customer);
         std::cout << "Test 3 PASSED: Customer Christina added successfully.\n\n";
     } catch (const std::exception& e) {
@@ -327,7 +331,7 @@ void runSpecificTests(RentalCompany& company) {
     SearchCriteria criteria;
     criteria.make = "Audi";
     criteria.model = "Q8";
-    auto results = company.searchVehicles(criteria);
+    auto results = company.findVehicles(criteria);
     if (!results.empty()) {
         std::cout << "Test 6 PASSED: Audi Q8 found.\n\n";
         displayVehicleSearchResults(results);
@@ -338,7 +342,7 @@ void runSpecificTests(RentalCompany& company) {
     // Test 7a: Adding new Car - V109 Toyota Corolla...
     std::cout << "Test 7a: Adding new Car - V109 Toyota Corolla...\n";
     try {
-        auto car = std::make_shared<Car>("V109", "Toyota", "Corolla", 5, 400, true);
+        auto car = makeVehicle(VehicleType::Car, "V109", "Toyota", "Corolla", 5, 400, true);
         company.addVehicle(car);
         std::cout << "Test 7a PASSED: Car V109 Toyota Corolla added successfully.\n\n";
     } catch (const std::exception& e) {
@@ -478,6 +482,37 @@ void handleDisplayCustomers(RentalCompany& company) {
     company.displayCustomers();
 }
 
+/**
+ * The function `readWithCompletion` reads one search term. A term ending in `*` is treated as a
+ * prefix: the most common completions are listed with how many records have each, and the user
+ * picks one by number, or 0 to search for the prefix itself.
+ *
+ * @param complete The `complete` parameter returns the completions for a prefix, most common first
+ * (for example `RentalCompany::completeMake`).
+ *
+ * @return The term to search for.
+ */
+std::string readWithCompletion(const std::function<std::vector<Completion>(const std::string&)>& complete) {
+    std::string text;
+    std::cin >> text;
+    if (text.empty() || text.back() != '*') {
+        return text;
+    }
+
+    text.pop_back();
+    const auto completions = complete(text);
+    if (completions.empty()) {
+        std::cout << "No suggestions for \"" << text << "\".\n";
+        return text;
+    }
+    for (std::size_t i = 0; i < completions.size(); ++i) {
+        std::cout << "  " << (i + 1) << ". " << completions[i].text << " (" << completions[i].count << ")\n";
+    }
+    std::cout << "  0. Keep \"" << text << "\"\n";
+    const int choice = getValidatedMenuChoice(0, static_cast<int>(completions.size()));
+    return choice == 0 ? text : completions[static_cast<std::size_t>(choice - 1)].text;
+}
+
 /**
  * The function `handleAddCustomer` in C++ prompts the user to enter a customer ID and name, then
  * attempts to add a new customer to a rental company, displaying success or failure messages
@@ -501,7 +536,9 @@ void handleSearchVehicles(RentalCompany& company) {
         std::cout << "4. Set Passenger Capacity\n";
         std::cout << "5. Set Storage Capacity\n";
         std::cout << "6. Set Availability\n";
-        std::cout << "7. Exit Search\n";
+        std::cout << "7. Set Passenger Range\n";
+        std::cout << "8. Set Storage Range\n";
+        std::cout << "9. Exit Search\n";
         std::cout << "Enter your choice: ";
         std::cin >> choice;
 
@@ -511,12 +548,12 @@ void handleSearchVehicles(RentalCompany& company) {
                 std::cin >> criteria.type;
                 break;
             case '2':
-                std::cout << "Enter Make: ";
-                std::cin >> criteria.make;
+                std::cout << "Enter Make (end with * for suggestions): ";
+                criteria.make = readWithCompletion([&company](const std::string& prefix) { return company.completeMake(prefix); });
                 break;
             case '3':
-                std::cout << "Enter Model: ";
-                std::cin >> criteria.model;
+                std::cout << "Enter Model (end with * for suggestions): ";
+                criteria.model = readWithCompletion([&company](const std::string& prefix) { return company.completeModel(prefix); });
                 break;
             case '4':
                 std::cout << "Enter Passenger Capacity: ";
@@ -535,6 +572,18 @@ void handleSearchVehicles(RentalCompany& company) {
                 }
                 break;
             case '7':
+                std::cout << "Enter Minimum Passengers (-1 for no minimum): ";
+                std::cin >> criteria.minPassengers;
+                std::cout << "Enter Maximum Passengers (-1 for no maximum): ";
+                std::cin >> criteria.maxPassengers;
+                break;
+            case '8':
+                std::cout << "Enter Minimum Storage (-1 for no minimum): ";
+                std::cin >> criteria.minStorage;
+                std::cout << "Enter Maximum Storage (-1 for no maximum): ";
+                std::cin >> criteria.maxStorage;
+                break;
+            case '9':
                 done = true;
                 break;
             default:
@@ -543,16 +592,9 @@ void handleSearchVehicles(RentalCompany& company) {
         }
 
         if (!done) {
-            auto results = searchItems(company.getVehicleRepository(), [&criteria](const std::shared_ptr<Vehicle>& vehicle) {
-                bool matches = true;
-                if (!criteria.type.empty() && vehicle->getType() != criteria.type) matches = false;
-                if (!criteria.make.empty() && levenshteinDistance(vehicle->getMake(), criteria.make) > criteria.maxDistanceMake) matches = false;
-                if (!criteria.model.empty() && levenshteinDistance(vehicle->getModel(), criteria.model) > criteria.maxDistanceModel) matches = false;
-                if (criteria.passengerCapacity != -1 && vehicle->getPassengers() != criteria.passengerCapacity) matches = false;
-                if (criteria.storageCapacity != -1 && vehicle->getCapacity() != criteria.storageCapacity) matches = false;
-                if (criteria.filterByAvailability && vehicle->getAvailability() != criteria.availability) matches = false;
-                return matches;
-            });
+            // Same compiled plan as RentalCompany::searchVehicles, so both honour every criterion;
+            // rows are filtered as the page is read unless the search is already cached
+            auto results = company.findVehicles(criteria);
             displayVehicleSearchResults(results);
         }
     }
@@ -588,14 +630,14 @@ void handleSearchCustomers(RentalCompany& company) {
                 std::cin >> criteria.customerID;
                 break;
             case '2':
-                std::cout << "Enter Name: ";
-                std::cin >> criteria.name;
+                std::cout << "Enter Name (end with * for suggestions): ";
+                criteria.name = readWithCompletion([&company](const std::string& prefix) { return company.completeCustomerName(prefix); });
                 break;
             case '3': {
-                auto results = searchItems(company.getCustomerRepository(), [&criteria](const std::shared_ptr<Customer>& customer) {
+                auto results = findItems(company.getCustomerRepository(), [&criteria](const Customer& customer) {
                     bool matches = true;
-                    if (criteria.customerID != -1 && customer->getCustomerID() != criteria.customerID) matches = false;
-                    if (!criteria.name.empty() && customer->getName() != criteria.name) matches = false;
+                    if (criteria.customerID != -1 && customer.getCustomerID() != criteria.customerID) matches = false;
+                    if (!criteria.name.empty() && customer.getName() != criteria.name) matches = false;
                     return matches;
                 });
                 displayCustomerSearchResults(results);
@@ -616,10 +658,10 @@ void handleSearchCustomers(RentalCompany& company) {
  * specific criteria, showing the vehicle type, ID, make, model, passengers, storage capacity,
  * availability, rental rate, and late fee for each vehicle.
  *
- * @param results The `results` parameter is a vector of shared pointers to `Vehicle` objects
- * containing the search results based on the search criteria provided by the user.
+ * @param results The `results` parameter is a lazy cursor over the vehicles matching the search
+ * criteria provided by the user; the rows are filtered and printed as the cursor is drained.
  */
-void displayVehicleSearchResults(const std::vector<std::shared_ptr<Vehicle>>& results) {
+void displayVehicleSearchResults(SearchCursor<Vehicle>& results) {
     if (results.empty()) {
         std::cout << "No vehicles found matching the criteria.\n";
         return;
@@ -636,10 +678,10 @@ void displayVehicleSearchResults(const std::vector<std::shared_ptr<Vehicle>>& re
  * on specific criteria, showing the customer ID, name, loyalty points, and rented vehicles for each
  * customer.
  *
- * @param results The `results` parameter is a vector of shared pointers to `Customer` objects
- * containing the search results based on the search criteria provided by the user.
+ * @param results The `results` parameter is a lazy cursor over the customers matching the search
+ * criteria provided by the user; the rows are filtered and printed as the cursor is drained.
  */
-void displayCustomerSearchResults(const std::vector<std::shared_ptr<Customer>>& results) {
+void displayCustomerSearchResults(SearchCursor<Customer>& results) {
     if (results.empty()) {
         std::cout << "No customers found matching the criteria.\n";
         return;
@@ -684,7 +726,7 @@ void handleAddCustomer(RentalCompany& company) {
     }
 
     try {
-        company.addCustomer(std::make_shared<Customer>(customerID, name));
+        company.addCustomer(makePooled<Customer>(customerID, name));
         std::cout << "Customer added successfully.\n\n";
     }
     catch (const std::exception& e) {
@@ -771,31 +813,8 @@ void handleAddVehicle(RentalCompany& company) {
     }
 
     try {
-        switch (vehicleType) {
-            case 1: {
-                auto car = std::make_shared<Car>(id, make, model, passengers, storage, avail);
-                company.addVehicle(car);
-                break;
-            }
-            case 2: {
-                auto van = std::make_shared<Van>(id, make, model, passengers, storage, avail);
-                company.addVehicle(van);
-                break;
-            }
-            case 3: {
-                auto minibus = std::make_shared<Minibus>(id, make, model, passengers, storage, avail);
-                company.addVehicle(minibus);
-                break;
-            }
-            case 4: {
-                auto suv = std::make_shared<SUV>(id, make, model, passengers, storage, avail);
-                company.addVehicle(suv);
-                break;
-            }
-            default:
-                std::cout << "Invalid vehicle type.\n";
-                return;
-        }
+        // Menu choices 1-4 follow the VehicleType order (Car, Van, Minibus, SUV)
+        company.addVehicle(makeVehicle(static_cast<VehicleType>(vehicleType - 1), id, make, model, passengers, storage, avail));
         std::cout << "Vehicle added successfully.\n\n";
     }
     catch (const std::exception& e) {